@@ -41,6 +41,11 @@ enum StringDescriptors_t
 // The Switch -needs- this to be 64.
 // The Wii U is flexible, allowing us to use the default of 8 (which did not match the original Hori descriptors).
 #define JOYSTICK_EPSIZE           64
+// Interrupt endpoint polling interval in ms, set with "make POLLING_MS=n".
+// Step timings don't depend on it; see REFERENCE_INTERVAL_MS.
+#ifndef POLLING_INTERVAL_MS
+	#define POLLING_INTERVAL_MS   5
+#endif
 // Descriptor Header Type - HID Class HID Descriptor
 #define DTYPE_HID                 0x21
 // Descriptor Header Type - HID Class HID Report Descriptor
@@ -28,8 +28,78 @@ these buttons for our use.
 #include "instructions.h"
 #include "settings.h"
 #include "egg_cycles.h"
-
+#include "timer.h"
+#include "feedback.h"
+#include "config.h"
+#include "checkpoint.h"
+#ifdef TRACE_RECORDER
+#include "recorder.h"
+
+#ifdef SERIAL_FEEDBACK
+#error "The recorder needs the serial port to itself, so can't be built with serial feedback"
+#endif
+_Static_assert(RECORDER_REPORT_SIZE == RAW_REPORT_SIZE, "recorded reports must fit RAW_STEP()");
+#endif
+#if defined(FANOUT_LEADER) || defined(FANOUT_FOLLOWER)
+#include "fanout.h"
+
+#if defined(FEEDBACK_ENABLED) || defined(TARGET_TRIGGER) || defined(TRACE_RECORDER)
+#error "Fan-out needs the serial port to itself, and feedback would only see one console"
+#endif
+_Static_assert(FANOUT_REPORT_SIZE == RAW_REPORT_SIZE, "fanned out reports must fit take_raw_report()");
+#ifdef FANOUT_LEADER
+// Each poll's frames for the followers go out at 10 bits a byte before the
+// next poll, or the followers at the back of the queue lose theirs
+_Static_assert((uint32_t)(FANOUT_CONSOLES - 1) * FANOUT_FRAME_SIZE * 10 * 1000 <= (uint32_t)FANOUT_BAUD * POLLING_INTERVAL_MS,
+	"too many consoles to send every follower a frame each poll at this polling interval");
+#endif
+#endif
+
+#ifdef WITH_IMAGE_DATA
 extern const uint8_t image_data[0x12c1] PROGMEM;
+#endif
+
+#ifdef COLLECT_STATS
+// Debug counters, read and cleared with vendor control requests
+typedef struct {
+	uint32_t state_reports[STATE_COUNT]; // Reports sent in each State_t
+	uint16_t egg_checks;                 // Times we spoke to the nursery worker
+	uint16_t eggs_received;              // Eggs seen by serial feedback
+	uint16_t bad_out_reports;            // OUT packets that weren't a whole report
+	uint16_t write_retries;              // IN reports that had to be sent again
+	uint32_t skipped_reports;            // Polls left unanswered, the report being unchanged
+	uint16_t resyncs;                    // Times the bot backed out to fly back to the nursery
+} stats_t;
+
+stats_t stats;
+
+#define STATS_COUNT(counter) stats.counter++
+#define STATS_ADD(counter, amount) stats.counter += (amount)
+
+// Expected run times, worked out from the step tables and settings when the
+// run starts, and a live estimate of how long is left. All in ms. The hatch
+// model is used as is, so runs with hatch feedback finish sooner.
+typedef struct {
+	uint32_t run_ms;               // Start to SLEEP, 0 for continuous runs
+	uint32_t first_box_ms;         // The first box, collection included
+	uint32_t box_ms;               // Each box after that
+	uint32_t last_box_ms;          // The last of those, with no next box to collect for
+	uint32_t first_collection_ms;  // Collecting for the first box
+	uint32_t collection_ms;        // Collecting for each box after that
+	uint32_t hatching_ms;          // Hatching all six columns of a box
+	uint32_t release_ms;           // Releasing a box
+	uint32_t elapsed_ms;           // So far
+	uint32_t remaining_ms;         // Left to go, 0xFFFFFFFF for continuous runs
+} estimate_t;
+
+estimate_t estimate;
+
+void estimate_run(void);
+uint32_t estimate_remaining(void);
+#else
+#define STATS_COUNT(counter)
+#define STATS_ADD(counter, amount)
+#endif
 
 // Main entry point.
 int main(void) {
@@ -40,10 +110,21 @@ int main(void) {
 	// Once that's done, we'll enter an infinite loop.
 	for (;;)
 	{
+		#ifdef WATCHDOG
+		// Still going, so no reset yet
+		wdt_reset();
+		#endif
 		// We need to run our task to process and deliver data for our IN and OUT endpoints.
 		HID_Task();
 		// We also need to run the main USB management task.
 		USB_USBTask();
+
+		#ifdef USB_IDLE_SLEEP
+		// Nothing else to do until the next interrupt: the 1 ms timer, the
+		// start of frame, or a control request (handled in the interrupt).
+		set_sleep_mode(SLEEP_MODE_IDLE);
+		sleep_mode();
+		#endif
 	}
 }
 
@@ -67,6 +148,30 @@ PORTD will toggle when printing is done.
 	DDRB  = 0xFF; //uses PORTB. Micro can use either or, but both give us 2 LEDs
 	PORTB =  0x0; //The ATmega328P on the UNO will be resetting, so unplug it?
 	#endif
+	#ifdef REPORT_RATE_BENCHMARK
+	// The measured report rate is shown on PORTD and PORTB.
+	DDRD  = 0xFF;
+	PORTD =  0x0;
+	DDRB  = 0xFF;
+	PORTB =  0x0;
+	#endif
+	// Settings saved by a host override the settings.h ones.
+	Config_Init();
+	// Hatch feedback inputs come after the alert pins, so they stay inputs.
+	Feedback_Init();
+	#ifdef TRACE_RECORDER
+	Recorder_Init();
+	#endif
+	#if defined(FANOUT_LEADER) || defined(FANOUT_FOLLOWER)
+	Fanout_Init();
+	#endif
+	#ifdef WATCHDOG
+	// If the main loop ever stops, the board resets and resumes from the last
+	// checkpoint
+	wdt_enable(WDTO_2S);
+	#endif
+	// All step timing runs off the millisecond timer.
+	Timer_Init();
 	// The USB stack should be initialized last.
 	USB_Init();
 }
@@ -89,18 +194,106 @@ void EVENT_USB_Device_ConfigurationChanged(void) {
 	ConfigSuccess &= Endpoint_ConfigureEndpoint(JOYSTICK_OUT_EPADDR, EP_TYPE_INTERRUPT, JOYSTICK_EPSIZE, 1);
 	ConfigSuccess &= Endpoint_ConfigureEndpoint(JOYSTICK_IN_EPADDR, EP_TYPE_INTERRUPT, JOYSTICK_EPSIZE, 1);
 
+	#if defined(REPORT_RATE_BENCHMARK) || defined(USB_IDLE_SLEEP)
+	// Start of frame events give us a 1 ms reference to measure against,
+	// and wake us from idle sleep at the start of every frame.
+	USB_Device_EnableSOFEvents();
+	#endif
+
 	// We can read ConfigSuccess to indicate a success or failure at this point.
 }
 
+#ifdef REPORT_RATE_BENCHMARK
+volatile uint16_t benchmark_frames = 0;
+volatile uint16_t benchmark_reports = 0;
+
+// Fired every 1 ms start of frame. Once a second, we show how many reports the host took.
+void EVENT_USB_Device_StartOfFrame(void) {
+	if (++benchmark_frames >= 1000)
+	{
+		PORTD = benchmark_reports & 0xFF;
+		PORTB = benchmark_reports >> 8;
+		benchmark_frames = 0;
+		benchmark_reports = 0;
+	}
+}
+#endif
+
 // Process control requests sent to the device from the USB host.
 void EVENT_USB_Device_ControlRequest(void) {
 	// We can handle two control requests: a GetReport and a SetReport.
 
 	// Not used here, it looks like we don't receive control request from the Switch.
+
+	#ifdef COLLECT_STATS
+	// A debug host can read the run time estimate
+	if (USB_ControlRequest.bRequest == ESTIMATE_REQUEST &&
+	    USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_VENDOR | REQREC_DEVICE))
+	{
+		uint16_t length = USB_ControlRequest.wLength;
+
+		if (length > sizeof(estimate_t))
+			length = sizeof(estimate_t);
+
+		estimate.elapsed_ms = get_time_ms();
+		estimate.remaining_ms = estimate_remaining();
+
+		Endpoint_ClearSETUP();
+		Endpoint_Write_Control_Stream_LE(&estimate, length);
+		Endpoint_ClearOUT();
+		return;
+	}
+
+	// Or the counters, or clear them
+	if (USB_ControlRequest.bRequest != STATS_REQUEST)
+		return;
+
+	if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_VENDOR | REQREC_DEVICE))
+	{
+		uint16_t length = USB_ControlRequest.wLength;
+
+		if (length > sizeof(stats_t))
+			length = sizeof(stats_t);
+
+		Endpoint_ClearSETUP();
+		Endpoint_Write_Control_Stream_LE(&stats, length);
+		Endpoint_ClearOUT();
+	}
+	else if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_VENDOR | REQREC_DEVICE))
+	{
+		Endpoint_ClearSETUP();
+		memset(&stats, 0, sizeof(stats_t));
+		Endpoint_ClearStatusStage();
+	}
+	#endif
 }
 
 // Process and deliver data from IN and OUT endpoints.
+_Static_assert(sizeof(USB_JoystickReport_Input_t) <= JOYSTICK_EPSIZE, "an IN report must fit in one packet");
+_Static_assert(ARRAY_SIZE(timing_profiles) == TIMING_PROFILES, "TIMING_PROFILES doesn't match timing_profiles[]");
+_Static_assert(ARRAY_SIZE(fragments) == FRAGMENT_COUNT, "fragment_t doesn't match fragments[]");
+
+#ifdef FANOUT_LEADER
+void GetFanoutReports(USB_JoystickReport_Input_t* const ReportData);
+#endif
+
+// Works out the next report for the host. A fan-out leader works out every
+// console's at once, and sends the others on to their followers.
+static inline void NextReport(USB_JoystickReport_Input_t* const ReportData) {
+	#ifdef FANOUT_LEADER
+	GetFanoutReports(ReportData);
+	#else
+	GetNextReport(ReportData);
+	#endif
+}
+
 void HID_Task(void) {
+	// The IN report waiting to go out. It's only replaced once the host has
+	// taken it, so a host that stops polling holds the state machine back
+	// rather than losing reports.
+	static USB_JoystickReport_Input_t JoystickInputData;
+	static bool report_pending = false;
+
 	// If the device isn't connected and properly configured, we can't do anything here.
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 		return;
@@ -110,16 +303,26 @@ void HID_Task(void) {
 	// We'll check to see if we received something on the OUT endpoint.
 	if (Endpoint_IsOUTReceived())
 	{
-		// If we did, and the packet has data, we'll react to it.
-		if (Endpoint_IsReadWriteAllowed())
+		// If we did, and the packet holds a whole report, we'll react to it.
+		// It's all in the bank already, so reading it never waits on the host.
+		// The descriptor's output report is a byte longer than the struct, so
+		// hosts that pad to it send 8 bytes; clearing the bank drops the rest.
+		if (Endpoint_IsReadWriteAllowed() && Endpoint_BytesInEndpoint() >= sizeof(USB_JoystickReport_Output_t))
 		{
 			// We'll create a place to store our data received from the host.
 			USB_JoystickReport_Output_t JoystickOutputData;
 			// We'll then take in that data, setting it up in our storage.
-			while(Endpoint_Read_Stream_LE(&JoystickOutputData, sizeof(JoystickOutputData), NULL) != ENDPOINT_RWSTREAM_NoError);
+			Endpoint_Read_Stream_LE(&JoystickOutputData, sizeof(JoystickOutputData), NULL);
 			// At this point, we can react to this data.
 
-			// However, since we're not doing anything with this data, we abandon it.
+			// The only data we use is config from a host; anything else is abandoned.
+			// New settings mean a new run, so don't resume the old one.
+			if (Config_Receive((const uint8_t*)&JoystickOutputData, sizeof(JoystickOutputData)))
+				Checkpoint_Clear();
+		}
+		else
+		{
+			STATS_COUNT(bad_out_reports);
 		}
 		// Regardless of whether we reacted to the data, we acknowledge an OUT packet on this endpoint.
 		Endpoint_ClearOUT();
@@ -130,14 +333,62 @@ void HID_Task(void) {
 	// We first check to see if the host is ready to accept data.
 	if (Endpoint_IsINReady())
 	{
-		// We'll create an empty report.
-		USB_JoystickReport_Input_t JoystickInputData;
-		// We'll then populate this report with what we want to send to the host.
-		GetNextReport(&JoystickInputData);
-		// Once populated, we can output this data to the host. We do this by first writing the data to the control stream.
-		while(Endpoint_Write_Stream_LE(&JoystickInputData, sizeof(JoystickInputData), NULL) != ENDPOINT_RWSTREAM_NoError);
-		// We then send an IN packet on this endpoint.
-		Endpoint_ClearIN();
+		#ifdef SKIP_UNCHANGED_REPORTS
+		// A report the same as the last one isn't sent, so the host's polls
+		// are NAKed for as long as nothing changes, apart from a keep-alive
+		// now and then. Without a poll to pace it, the state machine is
+		// stepped on the clock instead, about once per polling interval.
+		static USB_JoystickReport_Input_t LastSentData;
+		static uint32_t last_sent_ms = 0;
+		static uint32_t next_report_ms = 0;
+
+		if (!report_pending)
+		{
+			if (!timer_reached(next_report_ms))
+				return;
+
+			NextReport(&JoystickInputData);
+			next_report_ms = get_time_ms() + REPORT_PACE_MS;
+
+			if (!memcmp(&JoystickInputData, &LastSentData, sizeof(JoystickInputData)) &&
+			    !timer_reached(last_sent_ms + REPORT_KEEPALIVE_MS))
+			{
+				STATS_COUNT(skipped_reports);
+				return;
+			}
+
+			report_pending = true;
+		}
+		#else
+		// We'll then populate a report with what we want to send to the host.
+		if (!report_pending)
+		{
+			NextReport(&JoystickInputData);
+			report_pending = true;
+		}
+		#endif
+		// The report fits in one packet, so with the bank free this is a
+		// single write that doesn't wait. If it fails anyway (the bus went
+		// away under us), the same report goes out next time the host asks.
+		if (Endpoint_Write_Stream_LE(&JoystickInputData, sizeof(JoystickInputData), NULL) == ENDPOINT_RWSTREAM_NoError)
+		{
+			// We then send an IN packet on this endpoint.
+			Endpoint_ClearIN();
+			report_pending = false;
+
+			#ifdef SKIP_UNCHANGED_REPORTS
+			LastSentData = JoystickInputData;
+			last_sent_ms = get_time_ms();
+			#endif
+
+			#ifdef REPORT_RATE_BENCHMARK
+			benchmark_reports++;
+			#endif
+		}
+		else
+		{
+			STATS_COUNT(write_retries);
+		}
 	}
 }
 
@@ -239,379 +490,1302 @@ void take_action(action_t action, USB_JoystickReport_Input_t* const ReportData)
 }
 
 
-typedef enum {
-	SYNC_CONTROLLER,
-	BREATHE,
-	FLY_TO_NURSERY,
-	IN_OUT_NURSERY,
-	GO_TO_CIRCLE1,
-	CIRCLE1,
-	APPROACH_NPC,
-	SPEAK,
-	GO_TO_CIRCLE2,
-	GO_TO_CIRCLE3,
-	OPEN_BOX,
-	SELECT_COL,
-	GRAB_EGGS1_PRE,
-	GRAB_EGGS2_PRE,
-	GRAB_EGGS3_PRE,
-	GRAB_EGGS4_PRE,
-	GRAB_EGGS5_PRE,
-	GRAB_EGGS6_PRE,
-	SELECT_COL2,
-	GRAB_EGGS1_POST,
-	GRAB_EGGS2_POST,
-	GRAB_EGGS3_POST,
-	GRAB_EGGS4_POST,
-	GRAB_EGGS5_POST,
-	GRAB_EGGS6_POST,
-	CLOSE_BOX,
-	CIRCLE_CW,
-	FLY_TO_NURSERY2,
-	SAVE,
-	SLEEP,
-	DONE
-} State_t;
-
 State_t state = SYNC_CONTROLLER;
 
-#define ECHOES 2
-int echoes = 0;
-USB_JoystickReport_Input_t last_report;
+uint8_t step_echoes = ECHOES;
+
+// The current step (or circling state) runs from step_start until
+// step_deadline, in absolute time from get_time_ms()
+uint32_t step_start = 0;
+uint32_t step_deadline = 0;
+bool step_running = false;
 
-int duration_count = 0;
 int bufindex = 0;
 int portsval = 0;
-uint8_t num_boxes = number_of_boxes;
-uint8_t egg_count = initial_egg_checks;
+// When DONE next flashes the alert, so it doesn't hold up the reports
+uint32_t alert_toggle_ms = 0;
+// The boxes this run hatches, 0 for a continuous run, and how many are left
+uint8_t run_boxes = 0;
+uint8_t num_boxes = 0;
+uint8_t egg_count = 0;
 uint8_t egg_set = 1;
+// Egg checks left on the way back to this box, and how many have been made
+// for the next box so far
+uint8_t column_checks = 0;
+uint8_t banked_checks = 0;
+// Eggs handed over that haven't gone into a box being hatched yet, as
+// counted by egg feedback
+uint8_t eggs_banked = 0;
+// Whether egg feedback counted a whole box of eggs for this box, so that
+// every slot holds something to release once it's hatched
+uint8_t box_full = 0;
+// The box just hatched gets released once its last column is back in it
+uint8_t release_pending = 0;
 int breeding_duration = 5500;
+// Long waits as a percentage of the tested timings, from the timing profile
+uint8_t wait_percent = 100;
 uint8_t new_round = 0;
+// Set when a reset left eggs in the party, so they get hatched before the
+// boxes are touched
+uint8_t resuming = 0;
+#ifdef WATCHDOG
+// Columns hatched since the last resync, egg checks in a row that got no egg,
+// and where the run carries on from after a resync
+uint8_t resync_columns = 0;
+uint8_t dry_checks = 0;
+State_t resync_next;
+#endif
+
+// Egg checks in the middle of a box are for the next one
+uint8_t checks_left(void) {
+	#ifdef SERIAL_FEEDBACK
+	// Any more would be surplus, there are enough for the box
+	if (eggs_banked >= EGGS_PER_BOX)
+		return 0;
+	#endif
+
+	return (egg_set > 1) ? column_checks : egg_count;
+}
+
+// Only egg feedback can tell that a box is full, and so safe to release
+bool releasing(void) {
+	#ifdef SERIAL_FEEDBACK
+	return config.release;
+	#else
+	return false;
+	#endif
+}
+
+// Going all the way round the 32 boxes would bring a release run back to the
+// box before the first, where the party members went, and that's the box
+// it'd release next. So it stops one box short.
+#define RELEASE_RUN_BOXES (32 - 1)
+
+// Unpack a species' egg cycle class from the flash index
+uint8_t get_egg_cycle_class(uint16_t dex_number) {
+	uint8_t pair = pgm_read_byte(&egg_cycle_class_index[dex_number / 2]);
+
+	return (dex_number & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+// Look up the precomputed hatch time for a species
+uint16_t get_breeding_duration(uint16_t dex_number) {
+	return pgm_read_word(&breeding_durations[config.fast_hatch ? 1 : 0][get_egg_cycle_class(dex_number)]);
+}
+
+// Start timing the current step if it has only just begun. Each step picks up
+// from the previous deadline so timing doesn't drift, unless we're already
+// past it (the host stopped polling for a while), in which case the step gets
+// its full length from now so no input is cut short.
+void begin_step(uint32_t length_ms) {
+	if (step_running)
+		return;
+
+	uint32_t now = get_time_ms();
+
+	step_start = timer_reached(step_deadline) ? now : step_deadline;
+	step_deadline = step_start + length_ms;
+	step_running = true;
+}
+
+// Finish the current step, so the next one starts timing afresh. If it was
+// cut short, the next step starts now rather than at the old deadline.
+void end_step(void) {
+	if (!timer_reached(step_deadline))
+		step_deadline = get_time_ms();
+
+	step_running = false;
+}
+
+// How long a step lasts. Long waits are scaled by the timing profile.
+uint32_t step_length_ms(uint8_t action, uint8_t duration, uint8_t echoes) {
+	uint32_t ms = (uint32_t)(duration + 1) * REPORT_MS(echoes);
+
+	if (action == hang && duration > SHORT_DURATION_MAX)
+		ms = ms * wait_percent / 100;
+
+	return ms;
+}
+
+// True once every egg in the party has been seen hatching, and the last one
+// has had time to finish. Without feedback we never know, so never.
+bool column_hatched(void) {
+	#ifdef FEEDBACK_ENABLED
+	return hatch_count >= EGGS_PER_COLUMN && timer_reached(last_hatch_ms + HATCH_SETTLE_MS);
+	#else
+	return false;
+	#endif
+}
+
+// True once the target has hatched and had time to finish, so the run can
+// end on it
+bool target_hatched(void) {
+	#ifdef TARGET_TRIGGER
+	return target_found && timer_reached(target_found_ms + HATCH_SETTLE_MS);
+	#else
+	return false;
+	#endif
+}
+
+// The fragments being run, innermost last, and where each caller picks up
+typedef struct {
+	const command_t* steps;
+	uint8_t size;
+	uint8_t times;            // Runs left after this one
+	uint16_t return_index;    // The caller's bufindex, past the CALL()
+	uint8_t return_echoes;
+} call_frame_t;
+
+call_frame_t call_stack[CALL_DEPTH];
+uint8_t call_depth = 0;
+
+// The table that's running: the innermost fragment, or else the state's own
+void current_table(const command_t* steps, uint16_t steps_size, const command_t** table, uint16_t* size) {
+	if (call_depth) {
+		*table = call_stack[call_depth - 1].steps;
+		*size = call_stack[call_depth - 1].size;
+	}
+	else {
+		*table = steps;
+		*size = steps_size;
+	}
+}
+
+// Starts running a fragment from the CALL() at bufindex
+void call_fragment(const command_t* steps) {
+	uint8_t code = pgm_read_byte(&steps[bufindex]);
+	uint8_t fragment = pgm_read_byte(&steps[bufindex + 1]);
+
+	// Tables are written not to nest deeper than this, but don't run off
+	// the end of the stack if one does
+	if (call_depth == CALL_DEPTH) {
+		bufindex += 2;
+		return;
+	}
+
+	call_frame_t* frame = &call_stack[call_depth++];
+	step_table_t table;
+
+	memcpy_P(&table, &fragments[fragment], sizeof(step_table_t));
+	frame->steps = table.steps;
+	frame->size = table.size;
+	frame->times = code & DURATION_ESCAPE;
+	frame->return_index = bufindex + 2;
+	frame->return_echoes = step_echoes;
+
+	bufindex = 0;
+	step_echoes = ECHOES;
+}
+
+// Runs the innermost fragment again if it was called more than once, or
+// else goes back to its caller
+void end_fragment(void) {
+	call_frame_t* frame = &call_stack[call_depth - 1];
 
-inline void do_steps(const command_t* steps, uint16_t steps_size, USB_JoystickReport_Input_t* const ReportData, State_t nextState, int egg_counting) {
-	take_action(steps[bufindex].action, ReportData);
-	duration_count ++;
-	
-	if (duration_count > steps[bufindex].duration)
+	if (frame->times) {
+		frame->times--;
+		bufindex = 0;
+		step_echoes = ECHOES;
+		return;
+	}
+
+	bufindex = frame->return_index;
+	step_echoes = frame->return_echoes;
+	call_depth--;
+}
+
+// Decodes the step at bufindex, first applying any control codes in front of
+// it. A call moves *table on to the fragment. Returns the step's size in
+// bytes.
+uint8_t read_step(const command_t** table, uint16_t* size, uint8_t* action, uint8_t* duration) {
+	// Step tables are in flash, so decode straight from there
+	uint8_t code = pgm_read_byte(&(*table)[bufindex]);
+
+	// Control codes take effect right away without using up a report
+	while ((code >> 3) == set_echoes || (code >> 3) == call)
 	{
-		bufindex ++;
-		duration_count = 0;
+		if ((code >> 3) == set_echoes) {
+			step_echoes = code & DURATION_ESCAPE;
+			bufindex ++;
+		}
+		else {
+			call_fragment(*table);
+			current_table(*table, *size, table, size);
+		}
+
+		code = pgm_read_byte(&(*table)[bufindex]);
 	}
 
-	if (bufindex > steps_size - 1) 
+	*action = code >> 3;
+	*duration = code & DURATION_ESCAPE;
+
+	// Long steps carry their duration in the next byte, and raw ones their
+	// report after that
+	if (*duration == DURATION_ESCAPE)
 	{
-		bufindex = 0;
-		duration_count = 0;
-		if (egg_counting) {
-			egg_count--;
-			egg_set++;
+		*duration = pgm_read_byte(&(*table)[bufindex + 1]);
+		return (*action == raw_report) ? 2 + RAW_REPORT_SIZE : 2;
+	}
+
+	return 1;
+}
+
+// Fills in a report from the bytes of a RAW_STEP(), or from the recorder
+void take_raw_report(const uint8_t* raw, USB_JoystickReport_Input_t* const ReportData) {
+	ReportData->Button = raw[0] | (raw[1] << 8);
+	ReportData->HAT = raw[2];
+	ReportData->LX = raw[3];
+	ReportData->LY = raw[4];
+	ReportData->RX = raw[5];
+	ReportData->RY = raw[6];
+}
+
+// Runs a step table. Returns true once it has finished.
+bool do_steps(const command_t* steps, uint16_t steps_size, USB_JoystickReport_Input_t* const ReportData) {
+	const command_t* table;
+	uint16_t size;
+	uint8_t action, duration;
+
+	current_table(steps, steps_size, &table, &size);
+	uint8_t step_size = read_step(&table, &size, &action, &duration);
 
-			if (egg_set >= 7 ) {
-				egg_set = 1;
+	// Move on once the current step has run its course. Checking before
+	// acting means a step is never reported past its deadline.
+	if (step_running && timer_reached(step_deadline))
+	{
+		bufindex += step_size;
+		end_step();
+
+		// The end of a fragment goes back to its caller, which may be at
+		// its own end too
+		while (bufindex > size - 1)
+		{
+			if (!call_depth)
+			{
+				bufindex = 0;
+				step_echoes = ECHOES;
+				return true;
 			}
+
+			end_fragment();
+			current_table(steps, steps_size, &table, &size);
 		}
 
+		step_size = read_step(&table, &size, &action, &duration);
+	}
+
+	begin_step(step_length_ms(action, duration, step_echoes));
 
-		state = nextState;
-		reset_report(ReportData);
+	if (action == raw_report) {
+		uint8_t raw[RAW_REPORT_SIZE];
+		memcpy_P(raw, &table[bufindex + step_size - RAW_REPORT_SIZE], RAW_REPORT_SIZE);
+		take_raw_report(raw, ReportData);
+	}
+	else {
+		take_action(action, ReportData);
 	}
+
+	return false;
 }
 
+// States that aren't just a step table have a handler instead. Like
+// do_steps(), it returns true once the state has finished.
+bool sync_controller(USB_JoystickReport_Input_t* const ReportData) {
+	bufindex = 0;
+	call_depth = 0;
+	end_step();
+	run_boxes = config.boxes;
+	if (releasing() && (run_boxes == 0 || run_boxes > RELEASE_RUN_BOXES))
+		run_boxes = RELEASE_RUN_BOXES;
+	num_boxes = run_boxes;
+	egg_count = config.first_checks;
+	breeding_duration = get_breeding_duration(config.dex);
+
+	timing_profile_t profile;
+	memcpy_P(&profile, &timing_profiles[config.profile], sizeof(timing_profile_t));
+	wait_percent = profile.wait_percent;
+
+	#ifdef COLLECT_STATS
+	estimate_run();
+	#endif
 
-// Prepare the next report for the host.
-void GetNextReport(USB_JoystickReport_Input_t* const ReportData) {
+	// Pick up a run a reset interrupted. FLY_TO_NURSERY gets us back to a
+	// known spot from wherever we were.
+	#ifndef FANOUT_LEADER
+	checkpoint_t checkpoint;
+
+	// Anything out of range would run off the end of box_plan[] or the box
+	// count, so it's taken as a fresh start
+	if (Checkpoint_Load(&checkpoint) && checkpoint.running
+		&& checkpoint.egg_set >= 1 && checkpoint.egg_set <= 6
+		&& (run_boxes == 0 || (checkpoint.num_boxes >= 1 && checkpoint.num_boxes <= run_boxes))) {
+		resuming = checkpoint.hatching;
+		new_round = checkpoint.new_round;
+		num_boxes = checkpoint.num_boxes;
+		egg_set = checkpoint.egg_set;
+		egg_count = checkpoint.egg_count;
+		column_checks = checkpoint.column_checks;
+		banked_checks = checkpoint.banked_checks;
+		eggs_banked = checkpoint.eggs_banked;
+		box_full = checkpoint.box_full;
+		release_pending = checkpoint.release;
+	}
+	#endif
+	return true;
+}
 
-	// Prepare an empty report
-	reset_report(ReportData);
+// Moves the stick along a pattern, ms into it
+void do_pattern(const pattern_t* pattern_P, uint32_t elapsed_ms, USB_JoystickReport_Input_t* const ReportData) {
+	pattern_t pattern;
+	memcpy_P(&pattern, pattern_P, sizeof(pattern_t));
 
-	// Repeat ECHOES times the last report
-	if (echoes > 0)
-	{
-		memcpy(ReportData, &last_report, sizeof(USB_JoystickReport_Input_t));
-		echoes--;
-		return;
+	uint8_t angle = pattern.start + pattern.turn * (uint8_t)((elapsed_ms % pattern.lap_ms) * PATTERN_STEPS / pattern.lap_ms);
+	int8_t sine = pgm_read_byte(&sine_table[angle % PATTERN_STEPS]);
+	int8_t cosine = pgm_read_byte(&sine_table[(angle + PATTERN_STEPS / 4) % PATTERN_STEPS]);
+
+	// Screen up is the low end of LY
+	ReportData->LX = STICK_CENTER + cosine * pattern.radius / 127;
+	ReportData->LY = STICK_CENTER - sine * pattern.radius / 127;
+
+	if (pattern.press_every_ms && elapsed_ms % pattern.press_every_ms < pattern.press_ms)
+		take_action(pattern.press, ReportData);
+}
+
+bool circle1(USB_JoystickReport_Input_t* const ReportData) {
+	begin_step(CIRCLE1_MS);
+
+	if (timer_reached(step_deadline)) {
+		end_step();
+		bufindex = 0;
+		return true;
 	}
 
-	// States and moves management
-	switch (state)
-	{
-		case SYNC_CONTROLLER:
-			bufindex = 0;
-			duration_count = 0;
-			state = BREATHE;
-			if (flame_body) {
-				breeding_duration = (1.046 * (egg_cycles[nat_dex_number]/2)) - 32.583;
-			}
-			else {
-				breeding_duration = (1.046 * egg_cycles[nat_dex_number]) - 32.583;
-			}
-			break;
-		
-		case BREATHE:
-			do_steps(wake_up_hang, ARRAY_SIZE(wake_up_hang), ReportData, FLY_TO_NURSERY, 0);
-			break;
+	do_pattern(&circle1_pattern, get_time_ms() - step_start, ReportData);
+	return false;
+}
 
-		case FLY_TO_NURSERY:
-			if (egg_set > 1) {
-				do_steps(fly_to_breading_steps, ARRAY_SIZE(fly_to_breading_steps), ReportData, GO_TO_CIRCLE3, 0);
-			}
-			else if (new_round) {
-				do_steps(fly_to_breading_steps, ARRAY_SIZE(fly_to_breading_steps), ReportData, GO_TO_CIRCLE1, 0);
-			}
-			else {
-				do_steps(fly_to_breading_steps, ARRAY_SIZE(fly_to_breading_steps), ReportData, IN_OUT_NURSERY, 0);
-			}
-			break;
+bool circle_cw(USB_JoystickReport_Input_t* const ReportData) {
+	#ifdef FEEDBACK_ENABLED
+	if (!step_running)
+		hatch_count = 0;
+	#endif
+	begin_step((uint32_t)breeding_duration * REPORT_MS(ECHOES) + HATCH_PADDING_MS);
 
-		case IN_OUT_NURSERY:
-			do_steps(go_in_out_nursery, ARRAY_SIZE(go_in_out_nursery), ReportData, GO_TO_CIRCLE1, 0);
-			break;
+	// The hatch model is only an upper bound when feedback can tell us sooner.
+	// Checking before acting means we never circle past the deadline.
+	if (timer_reached(step_deadline) || column_hatched() || target_hatched()) {
+		end_step();
+		bufindex = 0;
+		return true;
+	}
 
-		case GO_TO_CIRCLE1:
-			if (new_round && egg_count > 0) {
-				do_steps(go_to_circle1, ARRAY_SIZE(go_to_circle1), ReportData, APPROACH_NPC, 0);
-			}
-			else if (egg_count > 0) {
-				do_steps(go_to_circle1, ARRAY_SIZE(go_to_circle1), ReportData, CIRCLE1, 0);
-			}
-			else {
-				egg_set = 1;
-				state = GO_TO_CIRCLE3;
-			}
-			break;
+	do_pattern(&circle_cw_pattern, get_time_ms() - step_start, ReportData);
+	return false;
+}
 
-		case CIRCLE1:
-			duration_count++;
+#define ALERT_TOGGLE_MS 250
 
-			if (duration_count % 48 <= 11) {
-				take_action(L_left, ReportData);
-			}
-			else if (duration_count % 48 <= 23) {
-				take_action(L_down, ReportData);
-			}
-			else if (duration_count % 48 <= 35) {
-				take_action(L_right, ReportData);
-			}
-			else if (duration_count % 48 <= 47) {
-				take_action(L_up, ReportData);
-			}
+bool done(USB_JoystickReport_Input_t* const ReportData) {
+	#ifdef ALERT_WHEN_DONE
+	if (timer_reached(alert_toggle_ms)) {
+		portsval = ~portsval;
+		PORTD = portsval; //flash LED(s) and sound buzzer if attached
+		PORTB = portsval;
+		alert_toggle_ms = get_time_ms() + ALERT_TOGGLE_MS;
+	}
+	#endif
+	return false;
+}
 
+#ifdef TRACE_RECORDER
+// Passes on whatever the recorder's host last sent, for as long as it's
+// plugged in. The recorder writes out the trace as it goes.
+bool record(USB_JoystickReport_Input_t* const ReportData) {
+	uint8_t raw[RECORDER_REPORT_SIZE];
 
-			if (duration_count > 350) {
-				duration_count = 0;
-				bufindex = 0;
-				state = APPROACH_NPC;
-			}
+	Recorder_Task(raw);
+	take_raw_report(raw, ReportData);
+	return false;
+}
+#endif
 
-			break;
-			
-		case APPROACH_NPC:
-			new_round = 0;
-			do_steps(approach, ARRAY_SIZE(approach), ReportData, SPEAK, 0);
-			break;
+#ifdef FANOUT_FOLLOWER
+// Passes on what the fan-out leader sends for this console
+bool follow(USB_JoystickReport_Input_t* const ReportData) {
+	uint8_t raw[FANOUT_REPORT_SIZE];
 
-		case SPEAK:
-			do_steps(speak, ARRAY_SIZE(speak), ReportData, GO_TO_CIRCLE2, 1);
-			break;
+	Fanout_Get(raw);
+	take_raw_report(raw, ReportData);
+	return false;
+}
+#endif
+
+// The box moves for a column, worked out when GRAB_EGGS_PRE/POST starts.
+// The party sits to the left of column 1 and the cursor wraps round from
+// column 6 back to the party, so every column is at most 3 moves away.
+uint8_t box_plan[10];
+uint8_t box_plan_size = 0;
+uint8_t box_plan_index = 0;
+
+void plan_moves(box_move_t move, uint8_t count) {
+	while (count--)
+		box_plan[box_plan_size++] = move;
+}
 
-		case GO_TO_CIRCLE2:
-			if (egg_count >= 1) {
-				do_steps(go_to_circle2, ARRAY_SIZE(go_to_circle2), ReportData, CIRCLE1, 0);
-			}
-			else {
-				egg_set = 1;
-				state = GO_TO_CIRCLE3;
-			}
-			break;
+// From the party to a box column the short way round
+void plan_from_party(uint8_t column) {
+	if (column <= 3)
+		plan_moves(box_right, column);
+	else
+		plan_moves(box_left, 7 - column);
+}
 
-		case GO_TO_CIRCLE3:
-			do_steps(go_to_circle3, ARRAY_SIZE(go_to_circle3), ReportData, OPEN_BOX, 0);
-			break;
+// From a box column back to the party the short way round
+void plan_to_party(uint8_t column) {
+	if (column <= 3)
+		plan_moves(box_left, column);
+	else
+		plan_moves(box_right, 7 - column);
+}
 
-		case OPEN_BOX:
-			do_steps(open_box, ARRAY_SIZE(open_box), ReportData, SELECT_COL, 0);
-			break;
+// Whether there are egg checks between this box's columns. Eggs collected
+// then go to the box that was showing when the boxes were last closed, and
+// this box's only empty column is the one in the party, so each box session
+// leaves the next box showing for them.
+bool column_pickups(void) {
+	return config.column_checks && (run_boxes == 0 || num_boxes > 1);
+}
 
-		case SELECT_COL:
-			switch(egg_set) {
-				case 1:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS1_PRE, 0);
-					break;
-				case 2:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS2_PRE, 0);
-					break;
-				case 3:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS3_PRE, 0);
-					break;
-				case 4:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS4_PRE, 0);
-					break;
-				case 5:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS5_PRE, 0);
-					break;
-				case 6:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS6_PRE, 0);
-					break;
-			}
-			break;
+// Holding the hatched party: put it back in the column the eggs came from,
+// which for column 1 is column 6 of the previous box, then move on to the
+// next column of eggs. If the previous box is to be released, RELEASE_BOX
+// does that and moves on instead. Between columns with pickups, the session
+// starts in the next box.
+void plan_grab_eggs_pre(bool pickups) {
+	uint8_t previous = (egg_set == 1) ? 6 : egg_set - 1;
+
+	plan_from_party(previous);
+	plan_moves(box_up, 1);
+
+	if (egg_set == 1) {
+		plan_moves(box_prev, 1);
+		plan_moves(box_drop, 1);
+
+		if (!release_pending) {
+			plan_moves(box_next, 1);
+			// Round through the party to column 1
+			plan_moves(box_right, 2);
+		}
+	}
+	else {
+		// Back from the next box, left showing for the pickups
+		if (pickups)
+			plan_moves(box_prev, 1);
 
-		case GRAB_EGGS1_PRE:
-			do_steps(grab_eggs1_pre, ARRAY_SIZE(grab_eggs1_pre), ReportData, SELECT_COL2, 0);
-			break;
+		plan_moves(box_drop, 1);
+		plan_moves(box_right, 1);
+	}
+}
 
-		case GRAB_EGGS2_PRE:
-			do_steps(grab_eggs2_pre, ARRAY_SIZE(grab_eggs2_pre), ReportData, SELECT_COL2, 0);
-			break;
+// Holding the eggs: take them back to the party. After the last column the
+// next box is where the next round's eggs are, and before then it's where
+// any pickups go.
+void plan_grab_eggs_post(bool pickups) {
+	if (egg_set == 6 || pickups)
+		plan_moves(box_next, 1);
 
-		case GRAB_EGGS3_PRE:
-			do_steps(grab_eggs3_pre, ARRAY_SIZE(grab_eggs3_pre), ReportData, SELECT_COL2, 0);
-			break;
+	plan_to_party(egg_set);
+	plan_moves(box_down, 1);
+}
 
-		case GRAB_EGGS4_PRE:
-			do_steps(grab_eggs4_pre, ARRAY_SIZE(grab_eggs4_pre), ReportData, SELECT_COL2, 0);
-			break;
+#define BOX_MOVES_END 0xFF
 
-		case GRAB_EGGS5_PRE:
-			do_steps(grab_eggs5_pre, ARRAY_SIZE(grab_eggs5_pre), ReportData, SELECT_COL2, 0);
-			break;
+uint8_t planned_move(uint8_t index) {
+	return (index < box_plan_size) ? box_plan[index] : BOX_MOVES_END;
+}
 
-		case GRAB_EGGS6_PRE:
-			do_steps(grab_eggs6_pre, ARRAY_SIZE(grab_eggs6_pre), ReportData, SELECT_COL2, 0);
-			break;
+// Releasing the previous box, from the top of its column 6 with the
+// multi-select cursor. There's no releasing more than one at a time, so
+// switch to the normal cursor and release each slot, back and forth along
+// the rows. That ends at the bottom of column 1, so go back up to the top of
+// column 6 (round through the party) and on to column 1 of the next box, in
+// multi-select again, just as GRAB_EGGS_PRE would have.
+#define BOX_SLOTS (6 * 5)
+
+uint8_t release_move(uint8_t index) {
+	if (index == 0)
+		return box_cursor;
+	index -= 1;
+
+	// A release, then the move to the next slot, for all but the last
+	if (index < 2 * BOX_SLOTS - 1) {
+		uint8_t slot = index / 2;
+
+		if (!(index & 1))
+			return box_release;
+		if (slot % 6 == 5)
+			return box_down;
+		return ((slot / 6) % 2) ? box_right : box_left;
+	}
+	index -= 2 * BOX_SLOTS - 1;
+
+	if (index < 4)
+		return box_up;
+	if (index < 6)
+		return box_left;
+	if (index < 8)
+		return box_cursor;
+	if (index < 9)
+		return box_next;
+	if (index < 11)
+		return box_right;
+	return BOX_MOVES_END;
+}
 
-		case SELECT_COL2:
-			switch(egg_set) {
-				case 1:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS1_POST, 0);
-					break;
-				case 2:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS2_POST, 0);
-					break;
-				case 3:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS3_POST, 0);
-					break;
-				case 4:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS4_POST, 0);
-					break;
-				case 5:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS5_POST, 0);
-					break;
-				case 6:
-					do_steps(select_col, ARRAY_SIZE(select_col), ReportData, GRAB_EGGS6_POST, 0);
-					break;
-			}
-			break;
-		
-		case GRAB_EGGS1_POST:
-			do_steps(grab_eggs1_post, ARRAY_SIZE(grab_eggs1_post), ReportData, CLOSE_BOX, 0);
-			break;
+// Runs the moves move_at() gives, from box_plan_index on. Returns true once
+// it has finished.
+bool do_box_moves(uint8_t (*move_at)(uint8_t index), USB_JoystickReport_Input_t* const ReportData) {
+	step_table_t table;
 
-		case GRAB_EGGS2_POST:
-			do_steps(grab_eggs2_post, ARRAY_SIZE(grab_eggs2_post), ReportData, CLOSE_BOX, 0);
-			break;
+	memcpy_P(&table, &box_moves[move_at(box_plan_index)], sizeof(step_table_t));
 
-		case GRAB_EGGS3_POST:
-			do_steps(grab_eggs3_post, ARRAY_SIZE(grab_eggs3_post), ReportData, CLOSE_BOX, 0);
-			break;
+	// Go straight on to the next move, so there's no gap between them
+	while (do_steps(table.steps, table.size, ReportData))
+	{
+		uint8_t move = move_at(++box_plan_index);
 
-		case GRAB_EGGS4_POST:
-			do_steps(grab_eggs4_post, ARRAY_SIZE(grab_eggs4_post), ReportData, CLOSE_BOX, 0);
-			break;
+		if (move == BOX_MOVES_END)
+		{
+			box_plan_index = 0;
+			box_plan_size = 0;
+			return true;
+		}
 
-		case GRAB_EGGS5_POST:
-			do_steps(grab_eggs5_post, ARRAY_SIZE(grab_eggs5_post), ReportData, CLOSE_BOX, 0);
-			break;
+		memcpy_P(&table, &box_moves[move], sizeof(step_table_t));
+	}
 
-		case GRAB_EGGS6_POST:
-			do_steps(grab_eggs6_post, ARRAY_SIZE(grab_eggs6_post), ReportData, CLOSE_BOX, 0);
-			break;
+	return false;
+}
 
-		case CLOSE_BOX:
-			do_steps(close_box, ARRAY_SIZE(close_box), ReportData, CIRCLE_CW, 1);
-			break;
+bool grab_eggs_pre(USB_JoystickReport_Input_t* const ReportData) {
+	if (box_plan_size == 0)
+		plan_grab_eggs_pre(column_pickups());
+
+	return do_box_moves(planned_move, ReportData);
+}
+
+bool release_box(USB_JoystickReport_Input_t* const ReportData) {
+	if (!do_box_moves(release_move, ReportData))
+		return false;
+
+	release_pending = 0;
+	return true;
+}
+
+bool grab_eggs_post(USB_JoystickReport_Input_t* const ReportData) {
+	if (box_plan_size == 0)
+		plan_grab_eggs_post(column_pickups());
+
+	return do_box_moves(planned_move, ReportData);
+}
 
+#ifdef WATCHDOG
+// Whether the state that's just finished shows the bot has lost its place in
+// the game, or it's time to make sure it hasn't anyway. An egg check is only
+// judged once the walk to the worker for the next one is over, so the 'E'
+// for it has had time to arrive.
+bool lost_place(State_t finished_state) {
+	switch (finished_state)
+	{
 		case CIRCLE_CW:
-			duration_count++;
+			#ifdef FEEDBACK_ENABLED
+			// Not one hatch in a whole column
+			if (hatch_count == 0)
+				return true;
+			#endif
+			return ++resync_columns >= RESYNC_COLUMNS;
 
-			if (duration_count % 48 <= 11) {
-				take_action(L_right, ReportData);
-			}
-			else if (duration_count % 48 <= 23) {
-				take_action(L_down, ReportData);
-			}
-			else if (duration_count % 48 <= 35) {
-				take_action(L_left, ReportData);
-			}
-			else if (duration_count % 48 <= 47) {
-				take_action(L_up, ReportData);
-			}
-			// if (duration_count > (breeding_duration - 500) && duration_count % 24 >= 0 && duration_count % 24 <= 5) {
-			if (duration_count % 24 >= 0 && duration_count % 24 <= 5) {
-				take_action(press_a, ReportData);
+		#ifdef SERIAL_FEEDBACK
+		case APPROACH_NPC:
+			return dry_checks >= DRY_CHECKS;
+		#endif
+
+		default:
+			return false;
+	}
+}
+#endif
+
+// Where a state goes once it has finished: either a State_t, or one of these
+// selectors for states whose next state depends on progress so far.
+enum {
+	NEXT_AFTER_SYNC = STATE_COUNT,
+	NEXT_AFTER_FLY,
+	NEXT_AFTER_GO_TO_CIRCLE1,
+	NEXT_AFTER_GO_TO_CIRCLE3,
+	NEXT_AFTER_GRAB_EGGS_PRE,
+	NEXT_AFTER_HATCHING,
+	NEXT_AFTER_SAVE,
+	NEXT_AFTER_RESYNC
+};
+
+// True while there are boxes still to hatch. A continuous run (number_of_boxes
+// 0) never runs out.
+bool boxes_left(void) {
+	return run_boxes == 0 || num_boxes > 0;
+}
+
+State_t select_next(uint8_t next) {
+	switch (next)
+	{
+		case NEXT_AFTER_SYNC:
+			#if defined(REPORT_RATE_BENCHMARK)
+			return BENCHMARK;
+			#elif defined(TRACE_RECORDER)
+			return RECORD;
+			#elif defined(TRACE_REPLAY)
+			return REPLAY;
+			#elif defined(FANOUT_FOLLOWER)
+			return FOLLOW;
+			#else
+			return BREATHE;
+			#endif
+
+		case NEXT_AFTER_FLY:
+			if (resuming)
+				return GO_TO_CIRCLE3;
+			if (egg_set > 1)
+				return column_checks ? GO_TO_CIRCLE1 : GO_TO_CIRCLE3;
+			return new_round ? GO_TO_CIRCLE1 : IN_OUT_NURSERY;
+
+		case NEXT_AFTER_GO_TO_CIRCLE1:
+			// An egg has been waiting all through the last hatch
+			return (new_round || egg_set > 1) ? APPROACH_NPC : CIRCLE1;
+
+		case NEXT_AFTER_GO_TO_CIRCLE3:
+			if (resuming) {
+				resuming = 0;
+				return CIRCLE_CW;
 			}
+			return OPEN_BOX;
 
+		case NEXT_AFTER_GRAB_EGGS_PRE:
+			return (egg_set == 1 && release_pending) ? RELEASE_BOX : SELECT_COL2;
 
-			if (duration_count > breeding_duration + 4200) {
-			//if (duration_count > 1) {
-				duration_count = 0;
-				bufindex = 0;
-				//break;
-
-				if (egg_set == 1) {
-					egg_count = subsequent_egg_checks;
-					num_boxes--;
-					
-					if ( (save == 1) || ((save == 2) && (num_boxes) <= 0) ) {
-						state = SAVE;
-					}
-					else if (num_boxes > 0) {
-						new_round = 1;
-						state = FLY_TO_NURSERY;
-					}
-					else {
-						state = SLEEP;
-					}
-				}
-				else {
-					state = FLY_TO_NURSERY;
-				}
+		case NEXT_AFTER_HATCHING:
+			// That's what the run was for, so keep it and stop
+			if (target_found)
+				return SAVE;
+
+			if (egg_set != 1) {
+				// Only worth collecting if there's another box to hatch
+				column_checks = column_pickups() ? config.column_checks : 0;
+				return FLY_TO_NURSERY;
 			}
 
-			break;
+			// That was the last column of the box
+			egg_count = (banked_checks < config.later_checks) ? config.later_checks - banked_checks : 0;
+			banked_checks = 0;
+			num_boxes--;
+			// Releasing an empty slot does nothing, and the presses after it
+			// would move the cursor instead, so only a full box is released
+			release_pending = releasing() && box_full;
+
+			if ( (config.save_mode == 1) || ((config.save_mode == 2) && !boxes_left()) )
+				return SAVE;
 
-		case SAVE:
-			if (num_boxes > 0) {
+			if (boxes_left()) {
 				new_round = 1;
-				do_steps(save_game, ARRAY_SIZE(save_game), ReportData, FLY_TO_NURSERY, 0);
+				return FLY_TO_NURSERY;
 			}
-			else {
-				do_steps(save_game, ARRAY_SIZE(save_game), ReportData, SLEEP, 0);
+
+			return SLEEP;
+
+		case NEXT_AFTER_SAVE:
+			if (boxes_left() && !target_found) {
+				new_round = 1;
+				return FLY_TO_NURSERY;
 			}
-			break;
-			
-		case SLEEP:
-			do_steps(sleep, ARRAY_SIZE(sleep), ReportData, DONE, 0);
-			break;
+			return SLEEP;
 
-		case DONE:
-			#ifdef ALERT_WHEN_DONE
-			portsval = ~portsval;
-			PORTD = portsval; //flash LED(s) and sound buzzer if attached
-			PORTB = portsval;
-			_delay_ms(250);
-			#endif
-			return;
+		#ifdef WATCHDOG
+		case NEXT_AFTER_RESYNC:
+			return resync_next;
+		#endif
+
+		default:
+			return next;
 	}
+}
+
+// Transition flags
+#define COUNTS_EGGS       0x01 // Finishing uses up an egg check
+#define NEXT_COLUMN       0x02 // Finishing moves on a column
+#define SKIP_WITHOUT_EGGS 0x04 // With no egg checks left, go straight to the boxes
+#define ENDS_NEW_ROUND    0x08 // Clears new_round
+#define CHECKPOINT        0x10 // Finishing is a safe point to resume from
+
+typedef bool (*state_handler_t)(USB_JoystickReport_Input_t* const ReportData);
+
+// One entry per State_t: what it runs and where it goes once that's done
+typedef struct {
+	const command_t* steps;   // Step table to run, or NULL to call the handler
+	uint16_t steps_size;
+	state_handler_t handler;
+	uint8_t flags;
+	uint8_t next;             // State_t or NEXT_* selector
+} transition_t;
+
+#define STEPS(steps)      steps, ARRAY_SIZE(steps), NULL
+#define HANDLER(handler)  NULL, 0, handler
+
+static const transition_t transitions[STATE_COUNT] PROGMEM = {
+	[SYNC_CONTROLLER] = { HANDLER(sync_controller),        0,                         NEXT_AFTER_SYNC },
+	[BREATHE]         = { STEPS(wake_up_hang),             0,                         FLY_TO_NURSERY },
+	[FLY_TO_NURSERY]  = { STEPS(fly_to_breading_steps),    0,                         NEXT_AFTER_FLY },
+	[IN_OUT_NURSERY]  = { STEPS(go_in_out_nursery),        0,                         GO_TO_CIRCLE1 },
+	[GO_TO_CIRCLE1]   = { STEPS(go_to_circle1),            SKIP_WITHOUT_EGGS,         NEXT_AFTER_GO_TO_CIRCLE1 },
+	[CIRCLE1]         = { HANDLER(circle1),                0,                         APPROACH_NPC },
+	[APPROACH_NPC]    = { STEPS(approach),                 ENDS_NEW_ROUND,            SPEAK },
+	[SPEAK]           = { STEPS(speak),                    COUNTS_EGGS,               GO_TO_CIRCLE2 },
+	[GO_TO_CIRCLE2]   = { STEPS(go_to_circle2),            SKIP_WITHOUT_EGGS,         CIRCLE1 },
+	[GO_TO_CIRCLE3]   = { STEPS(go_to_circle3),            0,                         NEXT_AFTER_GO_TO_CIRCLE3 },
+	[OPEN_BOX]        = { STEPS(open_box),                 0,                         SELECT_COL },
+	[SELECT_COL]      = { STEPS(select_col),               0,                         GRAB_EGGS_PRE },
+	[GRAB_EGGS_PRE]   = { HANDLER(grab_eggs_pre),          0,                         NEXT_AFTER_GRAB_EGGS_PRE },
+	[RELEASE_BOX]     = { HANDLER(release_box),            0,                         SELECT_COL2 },
+	[SELECT_COL2]     = { STEPS(select_col),               0,                         GRAB_EGGS_POST },
+	[GRAB_EGGS_POST]  = { HANDLER(grab_eggs_post),         0,                         CLOSE_BOX },
+	[CLOSE_BOX]       = { STEPS(close_box),                NEXT_COLUMN | CHECKPOINT,  CIRCLE_CW },
+	[CIRCLE_CW]       = { HANDLER(circle_cw),              0,                         NEXT_AFTER_HATCHING },
+	#ifdef WATCHDOG
+	[RESYNC]          = { STEPS(resync_steps),             0,                         NEXT_AFTER_RESYNC },
+	#else
+	[RESYNC]          = { HANDLER(done),                   0,                         DONE },
+	#endif
+	#if !defined(FIXED_SETTINGS) || save != 0 || defined(TARGET_TRIGGER)
+	[SAVE]            = { STEPS(save_game),                CHECKPOINT,                NEXT_AFTER_SAVE },
+	#endif
+	[SLEEP]           = { STEPS(sleep),                    CHECKPOINT,                DONE },
+	[DONE]            = { HANDLER(done),                   0,                         DONE },
+	#ifdef REPORT_RATE_BENCHMARK
+	[BENCHMARK]       = { STEPS(report_rate_test),         0,                         BENCHMARK },
+	#else
+	[BENCHMARK]       = { HANDLER(done),                   0,                         DONE },
+	#endif
+	#ifdef TRACE_RECORDER
+	[RECORD]          = { HANDLER(record),                 0,                         RECORD },
+	#else
+	[RECORD]          = { HANDLER(done),                   0,                         DONE },
+	#endif
+	#ifdef TRACE_REPLAY
+	[REPLAY]          = { STEPS(recorded_trace),           0,                         DONE },
+	#else
+	[REPLAY]          = { HANDLER(done),                   0,                         DONE },
+	#endif
+	#ifdef FANOUT_FOLLOWER
+	[FOLLOW]          = { HANDLER(follow),                 0,                         FOLLOW },
+	#else
+	[FOLLOW]          = { HANDLER(done),                   0,                         DONE },
+	#endif
+};
+
+// Saves where the run has got to, so a reset picks up from the state we've
+// just moved on to. A fan-out leader doesn't, as there's only room for one
+// console's run and the followers' consoles can't be picked up anyway.
+void save_checkpoint(void) {
+	#ifndef FANOUT_LEADER
+	// The last save moves on to SLEEP, and anything from there on has nothing
+	// left to resume
+	checkpoint_t checkpoint = {
+		.running       = (state < SAVE),
+		.hatching      = (state == CIRCLE_CW),
+		.new_round     = new_round,
+		.num_boxes     = num_boxes,
+		.egg_set       = egg_set,
+		.egg_count     = egg_count,
+		.column_checks = column_checks,
+		.banked_checks = banked_checks,
+		.eggs_banked   = eggs_banked,
+		.box_full      = box_full,
+		.release       = release_pending
+	};
+
+	Checkpoint_Save(&checkpoint);
+	#endif
+}
+
+#ifdef COLLECT_STATS
+// What the estimate is built from, worked out once by estimate_run()
+uint32_t check_ms;          // Each egg check after the first of a round
+uint32_t circle_cw_ms;
+uint32_t session_ms[6];     // From leaving the nursery to closing the box, per column
+uint32_t fly_ms;            // Flying back to the nursery after a column
+uint32_t pickups_ms;        // Collecting between columns, when there's a next box
+uint32_t resync_ms;         // Each column's share of the scheduled resyncs
+
+// A step only ends on a poll, at the first one at or after its deadline, and
+// the next step starts timing from there
+uint32_t poll_ms(uint32_t ms) {
+	return (ms + POLLING_INTERVAL_MS - 1) / POLLING_INTERVAL_MS * POLLING_INTERVAL_MS;
+}
+
+// How long a step table takes to run
+uint32_t table_ms(const command_t* steps, uint16_t size) {
+	uint32_t ms = 0;
+	uint8_t echoes = ECHOES;
+	uint16_t i = 0;
+
+	while (i < size)
+	{
+		uint8_t code = pgm_read_byte(&steps[i++]);
+		uint8_t duration = code & DURATION_ESCAPE;
+
+		if ((code >> 3) == set_echoes) {
+			echoes = duration;
+			continue;
+		}
+
+		if ((code >> 3) == call) {
+			step_table_t fragment;
+			memcpy_P(&fragment, &fragments[pgm_read_byte(&steps[i++])], sizeof(step_table_t));
+			ms += (uint32_t)(duration + 1) * table_ms(fragment.steps, fragment.size);
+			continue;
+		}
+
+		if (duration == DURATION_ESCAPE)
+			duration = pgm_read_byte(&steps[i++]);
+		if ((code >> 3) == raw_report)
+			i += RAW_REPORT_SIZE;
+
+		ms += poll_ms(step_length_ms(code >> 3, duration, echoes));
+	}
+
+	return ms;
+}
+
+// How long a state that runs a step table takes. The next state starts on the
+// poll after it finishes.
+uint32_t steps_ms(State_t s) {
+	transition_t entry;
+	memcpy_P(&entry, &transitions[s], sizeof(transition_t));
+	return table_ms(entry.steps, entry.steps_size) + POLLING_INTERVAL_MS;
+}
+
+// How long a run of box moves takes. Each move starts on the poll the last one
+// finished on.
+uint32_t moves_ms(uint8_t (*move_at)(uint8_t index)) {
+	uint32_t ms = POLLING_INTERVAL_MS;
+	step_table_t table;
+
+	for (uint8_t i = 0; move_at(i) != BOX_MOVES_END; i++)
+	{
+		memcpy_P(&table, &box_moves[move_at(i)], sizeof(step_table_t));
+		ms += table_ms(table.steps, table.size);
+	}
+
+	return ms;
+}
+
+// Collecting with some number of egg checks, if an egg is already waiting for
+// the first one. GO_TO_CIRCLE1 or GO_TO_CIRCLE2 finds none left and skips,
+// which takes a poll.
+uint32_t checks_ms(uint8_t checks, bool waiting) {
+	if (checks == 0)
+		return POLLING_INTERVAL_MS;
+
+	uint32_t ms = steps_ms(GO_TO_CIRCLE1) + steps_ms(APPROACH_NPC) + steps_ms(SPEAK)
+		+ (uint32_t)(checks - 1) * check_ms + POLLING_INTERVAL_MS;
 
-	// // Inking
+	if (!waiting)
+		ms += poll_ms(CIRCLE1_MS) + POLLING_INTERVAL_MS;
+
+	return ms;
+}
+
+// The hatching part of a box from column `column` on
+uint32_t hatching_from_ms(uint8_t column, bool pickups) {
+	uint32_t ms = 0;
+
+	for (uint8_t i = column; i <= 6; i++)
+	{
+		ms += session_ms[i - 1] + circle_cw_ms + resync_ms;
+
+		if (i < 6)
+			ms += fly_ms + (pickups ? pickups_ms : POLLING_INTERVAL_MS);
+	}
+
+	return ms;
+}
+
+void estimate_run(void) {
+	uint8_t later_checks = config.later_checks;
+	uint8_t pickups = (run_boxes == 1) ? 0 : config.column_checks;
+
+	check_ms = steps_ms(GO_TO_CIRCLE2) + poll_ms(CIRCLE1_MS) + POLLING_INTERVAL_MS + steps_ms(APPROACH_NPC) + steps_ms(SPEAK);
+	circle_cw_ms = poll_ms((uint32_t)breeding_duration * REPORT_MS(ECHOES) + HATCH_PADDING_MS) + POLLING_INTERVAL_MS;
+	fly_ms = steps_ms(FLY_TO_NURSERY);
+	pickups_ms = checks_ms(pickups, true);
+
+	// Which includes going to the next box at the end of one session and
+	// back at the start of the next
+	if (pickups) {
+		step_table_t table;
+
+		memcpy_P(&table, &box_moves[box_next], sizeof(step_table_t));
+		pickups_ms += table_ms(table.steps, table.size);
+		memcpy_P(&table, &box_moves[box_prev], sizeof(step_table_t));
+		pickups_ms += table_ms(table.steps, table.size);
+	}
+	#ifdef WATCHDOG
+	resync_ms = steps_ms(RESYNC) / RESYNC_COLUMNS;
+	#else
+	resync_ms = 0;
+	#endif
+
+	// Plan each column's box moves the way GRAB_EGGS_PRE/POST will, without
+	// pickups. Releasing is counted separately.
+	uint8_t saved_egg_set = egg_set;
+	uint8_t saved_release = release_pending;
+
+	release_pending = 0;
+
+	for (uint8_t column = 1; column <= 6; column++)
+	{
+		egg_set = column;
+
+		box_plan_size = 0;
+		plan_grab_eggs_pre(false);
+		session_ms[column - 1] = moves_ms(planned_move);
+		box_plan_size = 0;
+		plan_grab_eggs_post(false);
+		session_ms[column - 1] += moves_ms(planned_move);
+		box_plan_size = 0;
+
+		session_ms[column - 1] += steps_ms(GO_TO_CIRCLE3) + steps_ms(OPEN_BOX) + steps_ms(SELECT_COL) + steps_ms(SELECT_COL2) + steps_ms(CLOSE_BOX);
+	}
+
+	egg_set = saved_egg_set;
+	release_pending = saved_release;
+
+	// Pickups between columns take checks off the next round's collection
+	later_checks = (later_checks > 5 * pickups) ? later_checks - 5 * pickups : 0;
+
+	estimate.hatching_ms = hatching_from_ms(1, pickups);
+	estimate.release_ms = releasing() ? moves_ms(release_move) : 0;
+	estimate.first_collection_ms = fly_ms + steps_ms(IN_OUT_NURSERY) + checks_ms(config.first_checks, false);
+	estimate.collection_ms = fly_ms + checks_ms(later_checks, true);
+
+	estimate.first_box_ms = estimate.first_collection_ms + estimate.hatching_ms;
+	estimate.box_ms = estimate.collection_ms + estimate.hatching_ms + estimate.release_ms;
+
+	if (config.save_mode == 1) {
+		estimate.first_box_ms += steps_ms(SAVE);
+		estimate.box_ms += steps_ms(SAVE);
+	}
+
+	estimate.last_box_ms = estimate.box_ms - (estimate.hatching_ms - hatching_from_ms(1, false));
+
+	if (run_boxes == 0) {
+		estimate.run_ms = 0;
+		return;
+	}
+
+	// The last box has no next one to collect for
+	estimate.run_ms = POLLING_INTERVAL_MS + steps_ms(BREATHE) + estimate.first_box_ms
+		+ (uint32_t)(run_boxes - 1) * estimate.box_ms + steps_ms(SLEEP)
+		- (estimate.box_ms - estimate.last_box_ms);
+
+	if (config.save_mode == 2)
+		estimate.run_ms += steps_ms(SAVE);
+}
+
+// How much longer the run should take from here
+uint32_t estimate_remaining(void) {
+	if (run_boxes == 0)
+		return 0xFFFFFFFF;
+	if (state > SAVE || (state == SAVE && (!boxes_left() || target_found)))
+		return 0;
+
+	// Boxes after this one, the last of them without pickups, and the last box
+	// if it hasn't been released yet
+	uint32_t ms = release_pending ? estimate.release_ms : 0;
+	bool pickups = (num_boxes > 1);
+
+	if (pickups)
+		ms += (uint32_t)(num_boxes - 2) * estimate.box_ms + estimate.last_box_ms;
+
+	// Losing its place while collecting sends the bot back to the nursery to
+	// carry on collecting
+	bool collecting = (state < GO_TO_CIRCLE3);
+	#ifdef WATCHDOG
+	if (state == RESYNC && resync_next == FLY_TO_NURSERY && !new_round)
+		collecting = true;
+	#endif
+
+	if (state == SAVE)
+		// Saving between boxes, with all of the next one to go. How far into
+		// the save isn't tracked, so it's counted from the start.
+		return ms + steps_ms(SAVE) + estimate.collection_ms + hatching_from_ms(1, pickups);
+
+	if (egg_set == 1 && collecting && !resuming)
+		// Still collecting for this box
+		return ms + checks_left() * check_ms + hatching_from_ms(1, pickups);
+
+	if (state >= GO_TO_CIRCLE3 && state <= CLOSE_BOX)
+		// In the box session for column egg_set
+		return ms + hatching_from_ms(egg_set, pickups);
+
+	// Circling with column egg_set - 1, or on the way back from it
+	uint8_t column = (egg_set == 1) ? 6 : egg_set - 1;
+	ms += hatching_from_ms(column, pickups) - session_ms[column - 1];
+
+	if (state == CIRCLE_CW) {
+		uint32_t circled = step_running ? get_time_ms() - step_start : 0;
+		return ms - ((circled < circle_cw_ms) ? circled : circle_cw_ms);
+	}
+
+	return ms - circle_cw_ms;
+}
+#endif
+
+// Prepare the next report for the host.
+void GetNextReport(USB_JoystickReport_Input_t* const ReportData) {
+	transition_t entry;
+	bool finished;
+
+	// Prepare an empty report
+	reset_report(ReportData);
+
+	#if defined(FEEDBACK_ENABLED) || defined(TARGET_TRIGGER)
+	// Pick up any hatches since the last report, or the target
+	Feedback_Task();
+	#endif
+
+	#ifdef SERIAL_FEEDBACK
+	// And any eggs
+	#ifdef WATCHDOG
+	if (eggs_received)
+		dry_checks = 0;
+	#endif
+	eggs_banked += eggs_received;
+	STATS_ADD(eggs_received, eggs_received);
+	eggs_received = 0;
+	#endif
+
+	STATS_COUNT(state_reports[state]);
+
+	// States and moves management
+	memcpy_P(&entry, &transitions[state], sizeof(transition_t));
+
+	// Only as the state starts: an egg that arrives late, part way through
+	// one, mustn't cut its steps off where they are
+	if ((entry.flags & SKIP_WITHOUT_EGGS) && checks_left() == 0
+		&& bufindex == 0 && !step_running && call_depth == 0) {
+		// This box takes what's been collected for it, and any surplus
+		// carries over to the next one
+		if (egg_set == 1) {
+			box_full = (eggs_banked >= EGGS_PER_BOX);
+			eggs_banked = box_full ? eggs_banked - EGGS_PER_BOX : 0;
+		}
+
+		state = GO_TO_CIRCLE3;
+		return;
+	}
+
+	if (entry.flags & ENDS_NEW_ROUND)
+		new_round = 0;
+
+	if (entry.steps)
+		finished = do_steps(entry.steps, entry.steps_size, ReportData);
+	else
+		finished = entry.handler(ReportData);
+
+	if (!finished)
+		return;
+
+	#ifdef WATCHDOG
+	State_t finished_state = state;
+	#endif
+
+	if (entry.flags & COUNTS_EGGS) {
+		STATS_COUNT(egg_checks);
+		#if defined(WATCHDOG) && defined(SERIAL_FEEDBACK)
+		dry_checks++;
+		#endif
+
+		if (egg_set > 1) {
+			column_checks--;
+			banked_checks++;
+		}
+		else {
+			egg_count--;
+		}
+	}
+
+	if (entry.flags & NEXT_COLUMN) {
+		egg_set++;
+
+		if (egg_set >= 7 ) {
+			egg_set = 1;
+		}
+	}
+
+	state = select_next(entry.next);
+
+	if (entry.flags & CHECKPOINT)
+		save_checkpoint();
+
+	#ifdef WATCHDOG
+	// Back out to the overworld first. The counters are still right, only the
+	// game isn't where they say, so the run carries on as it would have, only
+	// collecting goes back to the nursery to find its way again.
+	if (lost_place(finished_state)) {
+		resync_next = (finished_state == APPROACH_NPC) ? FLY_TO_NURSERY : state;
+		resync_columns = 0;
+		dry_checks = 0;
+		STATS_COUNT(resyncs);
+		state = RESYNC;
+	}
+	#endif
+
+	// // Inking (needs image_data, build with PAYLOADS=image)
 	// if (state != SYNC_CONTROLLER && state != SYNC_POSITION)
 	// 	if (pgm_read_byte(&(image_data[(xpos / 8) + (ypos * 40)])) & 1 << (xpos % 8))
 	// 		ReportData->Button |= SWITCH_A;
+}
 
-	// Prepare to echo this report
-	memcpy(&last_report, ReportData, sizeof(USB_JoystickReport_Input_t));
-	echoes = ECHOES;
+#ifdef FANOUT_LEADER
+// Everything GetNextReport() keeps from one report to the next for a console.
+// The bot's state is global, so each console's is loaded in for its report
+// and saved again after. The settings, estimate and alert are shared.
+typedef struct {
+	State_t state;
+	uint8_t step_echoes;
+	uint32_t step_start;
+	uint32_t step_deadline;
+	bool step_running;
+	int bufindex;
+	call_frame_t call_stack[CALL_DEPTH];
+	uint8_t call_depth;
+	uint8_t num_boxes;
+	uint8_t egg_count;
+	uint8_t egg_set;
+	uint8_t column_checks;
+	uint8_t banked_checks;
+	uint8_t eggs_banked;
+	uint8_t box_full;
+	uint8_t release_pending;
+	int breeding_duration;
+	uint8_t new_round;
+	uint8_t resuming;
+	#ifdef WATCHDOG
+	uint8_t resync_columns;
+	uint8_t dry_checks;
+	State_t resync_next;
+	#endif
+	uint8_t box_plan[sizeof(box_plan)];
+	uint8_t box_plan_size;
+	uint8_t box_plan_index;
+} console_t;
+
+// Every console but the leader's own, which runs in the globals
+console_t consoles[FANOUT_CONSOLES - 1];
+
+void save_console(console_t* console) {
+	console->state             = state;
+	console->step_echoes       = step_echoes;
+	console->step_start        = step_start;
+	console->step_deadline     = step_deadline;
+	console->step_running      = step_running;
+	console->bufindex          = bufindex;
+	console->call_depth        = call_depth;
+	console->num_boxes         = num_boxes;
+	console->egg_count         = egg_count;
+	console->egg_set           = egg_set;
+	console->column_checks     = column_checks;
+	console->banked_checks     = banked_checks;
+	console->eggs_banked       = eggs_banked;
+	console->box_full          = box_full;
+	console->release_pending   = release_pending;
+	console->breeding_duration = breeding_duration;
+	console->new_round         = new_round;
+	console->resuming          = resuming;
+	#ifdef WATCHDOG
+	console->resync_columns    = resync_columns;
+	console->dry_checks        = dry_checks;
+	console->resync_next       = resync_next;
+	#endif
+	console->box_plan_size     = box_plan_size;
+	console->box_plan_index    = box_plan_index;
+	memcpy(console->call_stack, call_stack, sizeof(call_stack));
+	memcpy(console->box_plan, box_plan, sizeof(box_plan));
+}
 
+void load_console(const console_t* console) {
+	state             = console->state;
+	step_echoes       = console->step_echoes;
+	step_start        = console->step_start;
+	step_deadline     = console->step_deadline;
+	step_running      = console->step_running;
+	bufindex          = console->bufindex;
+	call_depth        = console->call_depth;
+	num_boxes         = console->num_boxes;
+	egg_count         = console->egg_count;
+	egg_set           = console->egg_set;
+	column_checks     = console->column_checks;
+	banked_checks     = console->banked_checks;
+	eggs_banked       = console->eggs_banked;
+	box_full          = console->box_full;
+	release_pending   = console->release_pending;
+	breeding_duration = console->breeding_duration;
+	new_round         = console->new_round;
+	resuming          = console->resuming;
+	#ifdef WATCHDOG
+	resync_columns    = console->resync_columns;
+	dry_checks        = console->dry_checks;
+	resync_next       = console->resync_next;
+	#endif
+	box_plan_size     = console->box_plan_size;
+	box_plan_index    = console->box_plan_index;
+	memcpy(call_stack, console->call_stack, sizeof(call_stack));
+	memcpy(box_plan, console->box_plan, sizeof(box_plan));
 }
 
+// Works out the leader's report and every follower's. Each console waits
+// FANOUT_OFFSET_MS longer than the one before to start, with nothing
+// pressed until then.
+void GetFanoutReports(USB_JoystickReport_Input_t* const ReportData) {
+	static bool started = false;
+	// Kept off the stack, so the data size the build reports counts it
+	static console_t leader;
+	USB_JoystickReport_Input_t report;
+
+	// Before anything has run, so every console starts out the way the
+	// globals do
+	if (!started) {
+		for (uint8_t i = 0; i < FANOUT_CONSOLES - 1; i++)
+			save_console(&consoles[i]);
+		started = true;
+	}
+
+	GetNextReport(ReportData);
+	save_console(&leader);
+
+	for (uint8_t i = 0; i < FANOUT_CONSOLES - 1; i++)
+	{
+		if (timer_reached((uint32_t)(i + 1) * FANOUT_OFFSET_MS)) {
+			load_console(&consoles[i]);
+			GetNextReport(&report);
+			save_console(&consoles[i]);
+		}
+		else {
+			reset_report(&report);
+		}
 
+		Fanout_Send(i + 1, (const uint8_t*)&report);
+	}
+
+	load_console(&leader);
+}
+#endif
@@ -42,6 +42,9 @@
 #include <avr/power.h>
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
+#ifdef USB_IDLE_SLEEP
+#include <avr/sleep.h>
+#endif
 #include <string.h>
 
 #include <LUFA/Drivers/USB/USB.h>
@@ -52,6 +55,20 @@
 
 #include "Descriptors.h"
 
+// Sleeping between wakeups means a report can go out up to a millisecond
+// after the host took the last one, which is only safe if it polls slower.
+#if defined(USB_IDLE_SLEEP) && (POLLING_INTERVAL_MS < 2)
+	#error USB_IDLE_SLEEP needs a polling interval of at least 2 ms
+#endif
+
+// With SKIP_UNCHANGED_REPORTS, the longest the host goes without a report
+// while nothing changes, and how often the next report is worked out. That's
+// a millisecond early, so a change is ready for the host's next poll.
+#ifndef REPORT_KEEPALIVE_MS
+	#define REPORT_KEEPALIVE_MS 100
+#endif
+#define REPORT_PACE_MS ((POLLING_INTERVAL_MS > 1) ? POLLING_INTERVAL_MS - 1 : 1)
+
 // Type Defines
 // Enumeration for joystick buttons.
 typedef enum {
@@ -109,6 +126,45 @@ typedef struct {
 	uint8_t  RY;     // Right Stick Y
 } USB_JoystickReport_Output_t;
 
+// The bot's states. GetNextReport() works through them from SYNC_CONTROLLER.
+typedef enum {
+	SYNC_CONTROLLER,
+	BREATHE,
+	FLY_TO_NURSERY,
+	IN_OUT_NURSERY,
+	GO_TO_CIRCLE1,
+	CIRCLE1,
+	APPROACH_NPC,
+	SPEAK,
+	GO_TO_CIRCLE2,
+	GO_TO_CIRCLE3,
+	OPEN_BOX,
+	SELECT_COL,
+	GRAB_EGGS_PRE,
+	RELEASE_BOX,
+	SELECT_COL2,
+	GRAB_EGGS_POST,
+	CLOSE_BOX,
+	CIRCLE_CW,
+	RESYNC,
+	SAVE,
+	SLEEP,
+	DONE,
+	BENCHMARK,
+	RECORD,
+	REPLAY,
+	FOLLOW,
+	STATE_COUNT
+} State_t;
+
+#ifdef COLLECT_STATS
+// Vendor control request to read (device to host) or clear (host to device)
+// the debug counters
+#define STATS_REQUEST 0x53
+// Vendor control request to read the run time estimate (device to host)
+#define ESTIMATE_REQUEST 0x45
+#endif
+
 // Function Prototypes
 // Setup all necessary hardware, including USB initialization.
 void SetupHardware(void);
@@ -119,6 +175,7 @@ void EVENT_USB_Device_Connect(void);
 void EVENT_USB_Device_Disconnect(void);
 void EVENT_USB_Device_ConfigurationChanged(void);
 void EVENT_USB_Device_ControlRequest(void);
+void EVENT_USB_Device_StartOfFrame(void);
 // Prepare the next report for the host.
 void GetNextReport(USB_JoystickReport_Input_t* const ReportData);
 
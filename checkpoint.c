@@ -0,0 +1,106 @@
+#include <avr/eeprom.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "checkpoint.h"
+#include "config.h"
+
+typedef struct {
+	uint16_t key;           // Which settings and layout the run was saved under
+	uint8_t sequence;
+	checkpoint_t checkpoint;
+	uint8_t checksum;
+} checkpoint_slot_t;
+
+static checkpoint_slot_t EEMEM slots[CHECKPOINT_SLOTS];
+
+// Where the newest checkpoint is, once Checkpoint_Load() has looked
+static uint8_t newest_slot = CHECKPOINT_SLOTS - 1;
+static uint8_t newest_sequence = 0;
+static bool searched = false;
+// Set once the run's been cleared. The run still going is the old one, so
+// it mustn't checkpoint itself back in.
+static bool cleared = false;
+
+// Blank EEPROM reads 0xFF throughout, which doesn't add up
+static uint8_t checksum(const checkpoint_slot_t* slot) {
+	const uint8_t* bytes = (const uint8_t*)slot;
+	uint8_t sum = 0;
+
+	for (uint8_t i = 0; i < offsetof(checkpoint_slot_t, checksum); i++)
+		sum += bytes[i];
+
+	return ~sum;
+}
+
+// A run only picks up a checkpoint saved under the settings it's starting
+// with. Reflashing with other settings.h values, or saving new ones over
+// USB, starts afresh, and a FIXED_SETTINGS build has no other way to.
+static uint16_t run_key(void) {
+	const uint8_t* bytes = (const uint8_t*)&config;
+	uint16_t key = CHECKPOINT_VERSION;
+
+	for (uint8_t i = 0; i < sizeof(config_t); i++)
+		key = ((key << 1) | (key >> 15)) + bytes[i];
+
+	return key;
+}
+
+bool Checkpoint_Load(checkpoint_t* checkpoint) {
+	checkpoint_slot_t slot;
+	bool found = false;
+	bool matches = false;
+
+	for (uint8_t i = 0; i < CHECKPOINT_SLOTS; i++)
+	{
+		eeprom_read_block(&slot, &slots[i], sizeof(checkpoint_slot_t));
+
+		if (slot.checksum != checksum(&slot))
+			continue;
+
+		// Sequence numbers wrap, but the slots are never more than
+		// CHECKPOINT_SLOTS apart
+		if (!found || (int8_t)(slot.sequence - newest_sequence) > 0)
+		{
+			newest_slot = i;
+			newest_sequence = slot.sequence;
+			*checkpoint = slot.checkpoint;
+			found = true;
+			matches = (slot.key == run_key());
+		}
+	}
+
+	searched = true;
+	return found && matches;
+}
+
+void Checkpoint_Save(const checkpoint_t* checkpoint) {
+	checkpoint_slot_t slot;
+
+	if (cleared)
+		return;
+
+	if (!searched)
+	{
+		checkpoint_t newest;
+		Checkpoint_Load(&newest);
+	}
+
+	newest_slot = (newest_slot + 1) % CHECKPOINT_SLOTS;
+	newest_sequence++;
+
+	slot.sequence = newest_sequence;
+	slot.key = run_key();
+	slot.checkpoint = *checkpoint;
+	slot.checksum = checksum(&slot);
+
+	eeprom_update_block(&slot, &slots[newest_slot], sizeof(checkpoint_slot_t));
+}
+
+void Checkpoint_Clear(void) {
+	checkpoint_t checkpoint;
+
+	memset(&checkpoint, 0, sizeof(checkpoint_t));
+	Checkpoint_Save(&checkpoint);
+	cleared = true;
+}
@@ -0,0 +1,41 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// How far a run has got, saved to EEPROM at safe points so a reset can pick
+// up where it left off instead of starting over.
+typedef struct {
+	uint8_t running;        // 0 once the run has finished or been cleared
+	uint8_t hatching;       // Resume by hatching the eggs in the party
+	uint8_t new_round;
+	uint8_t num_boxes;
+	uint8_t egg_set;
+	uint8_t egg_count;
+	uint8_t column_checks;
+	uint8_t banked_checks;
+	uint8_t eggs_banked;
+	uint8_t box_full;
+	uint8_t release;        // The box before this one is still to be released
+} checkpoint_t;
+
+// Checkpoints go round a ring of slots rather than always rewriting the same
+// bytes, which spreads the EEPROM wear. Each slot has a sequence number, so
+// the newest can be found on startup, and a checksum, so a slot torn by a
+// reset part way through writing it is skipped in favour of the one before.
+#define CHECKPOINT_SLOTS 16
+
+// Bump when checkpoint_t changes, so checkpoints saved by an older build are
+// ignored
+#define CHECKPOINT_VERSION 3
+
+// Finds the newest checkpoint. Returns false if there's none, or it was saved
+// by a run with other settings, or another CHECKPOINT_VERSION.
+bool Checkpoint_Load(checkpoint_t* checkpoint);
+void Checkpoint_Save(const checkpoint_t* checkpoint);
+// Forgets the run in progress, so the next start is a fresh one. Nothing
+// more is saved until then, so the run that's still going can't be resumed.
+void Checkpoint_Clear(void);
+
+#endif
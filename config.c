@@ -0,0 +1,157 @@
+#include <avr/eeprom.h>
+
+#include "config.h"
+#include "settings.h"
+#include "egg_cycles.h"
+
+#ifndef FIXED_SETTINGS
+
+config_t config;
+
+static uint8_t EEMEM saved_version;
+static config_t EEMEM saved_config;
+
+static void load_defaults(config_t* c) {
+	c->dex           = nat_dex_number;
+	c->boxes         = number_of_boxes;
+	c->save_mode     = save;
+	c->fast_hatch    = flame_body;
+	c->first_checks  = initial_egg_checks;
+	c->later_checks  = subsequent_egg_checks;
+	c->column_checks = column_egg_checks;
+	c->release       = release_boxes;
+	c->profile       = timing_profile;
+}
+
+// Sets one field, if the value is in range for it
+static bool set_field(config_t* c, uint8_t field, uint16_t value) {
+	switch (field)
+	{
+		case CONFIG_DEX:
+			if (value == 0 || value > LAST_DEX_NUMBER)
+				return false;
+			c->dex = value;
+			return true;
+
+		case CONFIG_BOXES:
+			if (value > 0xFF)
+				return false;
+			c->boxes = value;
+			return true;
+
+		case CONFIG_SAVE:
+			if (value > 2)
+				return false;
+			c->save_mode = value;
+			return true;
+
+		case CONFIG_FLAME_BODY:
+			if (value > 1)
+				return false;
+			c->fast_hatch = value;
+			return true;
+
+		case CONFIG_INITIAL_CHECKS:
+			if (value > 0xFF)
+				return false;
+			c->first_checks = value;
+			return true;
+
+		case CONFIG_SUBSEQUENT_CHECKS:
+			if (value > 0xFF)
+				return false;
+			c->later_checks = value;
+			return true;
+
+		case CONFIG_COLUMN_CHECKS:
+			if (value > 0xFF)
+				return false;
+			c->column_checks = value;
+			return true;
+
+		case CONFIG_RELEASE:
+			if (value > 1)
+				return false;
+			c->release = value;
+			return true;
+
+		case CONFIG_PROFILE:
+			if (value >= TIMING_PROFILES)
+				return false;
+			c->profile = value;
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+// Saved settings only count if every field is one a config report could have
+// set, so a corrupted byte can't index a table out of bounds
+static bool valid(const config_t* c) {
+	config_t checked;
+
+	return set_field(&checked, CONFIG_DEX, c->dex)
+		&& set_field(&checked, CONFIG_BOXES, c->boxes)
+		&& set_field(&checked, CONFIG_SAVE, c->save_mode)
+		&& set_field(&checked, CONFIG_FLAME_BODY, c->fast_hatch)
+		&& set_field(&checked, CONFIG_INITIAL_CHECKS, c->first_checks)
+		&& set_field(&checked, CONFIG_SUBSEQUENT_CHECKS, c->later_checks)
+		&& set_field(&checked, CONFIG_COLUMN_CHECKS, c->column_checks)
+		&& set_field(&checked, CONFIG_RELEASE, c->release)
+		&& set_field(&checked, CONFIG_PROFILE, c->profile);
+}
+
+// The saved settings, or the settings.h ones if none are saved or they
+// don't make sense
+static void load(config_t* c) {
+	if (eeprom_read_byte(&saved_version) == CONFIG_VERSION) {
+		eeprom_read_block(c, &saved_config, sizeof(config_t));
+
+		if (valid(c))
+			return;
+	}
+
+	load_defaults(c);
+}
+
+static void store(const config_t* c) {
+	// Only rewrites bytes that changed, to spare the EEPROM
+	eeprom_update_block(c, &saved_config, sizeof(config_t));
+	eeprom_update_byte(&saved_version, CONFIG_VERSION);
+}
+
+void Config_Init(void) {
+	load(&config);
+}
+
+// The run goes on with the settings it started with, so only the saved ones
+// change
+bool Config_Receive(const uint8_t* report, uint8_t size) {
+	if (size < 7)
+		return false;
+
+	uint16_t magic = report[0] | (report[1] << 8);
+	uint16_t value = report[3] | (report[4] << 8);
+	uint16_t check = report[5] | (report[6] << 8);
+
+	if (magic != CONFIG_MAGIC || (uint16_t)(value ^ check) != 0xFFFF)
+		return false;
+
+	config_t saved;
+
+	if (report[2] == CONFIG_DEFAULTS) {
+		load_defaults(&saved);
+	}
+	else {
+		load(&saved);
+
+		if (!set_field(&saved, report[2], value))
+			return false;
+	}
+
+	store(&saved);
+	return true;
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Runtime settings, kept in EEPROM so one image serves every species. They
+// start out as the settings.h values, and a host can change them by writing
+// OUT reports to the controller (see Config_Receive()). Changes are saved
+// right away and take effect the next time the bot starts.
+typedef struct {
+	uint16_t dex;            // nat_dex_number
+	uint8_t  boxes;          // number_of_boxes
+	uint8_t  save_mode;      // save
+	uint8_t  fast_hatch;     // flame_body
+	uint8_t  first_checks;   // initial_egg_checks
+	uint8_t  later_checks;   // subsequent_egg_checks
+	uint8_t  column_checks;  // column_egg_checks
+	uint8_t  release;        // release_boxes
+	uint8_t  profile;        // timing_profile
+} config_t;
+
+// How many timing profiles there are, in timing_profiles[] in instructions.h
+#define TIMING_PROFILES 3
+
+// A config OUT report has CONFIG_MAGIC in Button, the field in HAT, the new
+// value little-endian in LX/LY and its complement in RX/RY, so the Switch's
+// own OUT reports can't be mistaken for one. CONFIG_DEFAULTS puts every
+// field back to its settings.h value.
+#define CONFIG_MAGIC 0xC0DE
+
+enum {
+	CONFIG_DEFAULTS,
+	CONFIG_DEX,
+	CONFIG_BOXES,
+	CONFIG_SAVE,
+	CONFIG_FLAME_BODY,
+	CONFIG_INITIAL_CHECKS,
+	CONFIG_SUBSEQUENT_CHECKS,
+	CONFIG_COLUMN_CHECKS,
+	CONFIG_RELEASE,
+	CONFIG_PROFILE
+};
+
+// Bump when config_t changes, so old EEPROM contents are ignored
+#define CONFIG_VERSION 3
+
+#ifdef FIXED_SETTINGS
+// Built for one setup ("make fixed-settings"): the settings.h values are
+// baked in as constants, so the compiler folds away every branch they rule
+// out, and there's no EEPROM config or OUT report protocol.
+#include "settings.h"
+
+static const config_t config = {
+	.dex           = nat_dex_number,
+	.boxes         = number_of_boxes,
+	.save_mode     = save,
+	.fast_hatch    = flame_body,
+	.first_checks  = initial_egg_checks,
+	.later_checks  = subsequent_egg_checks,
+	.column_checks = column_egg_checks,
+	.release       = release_boxes,
+	.profile       = timing_profile
+};
+
+static inline void Config_Init(void) {}
+static inline bool Config_Receive(const uint8_t* report, uint8_t size) { return false; }
+#else
+extern config_t config;
+
+// Loads the saved settings, or the settings.h ones if none are saved.
+void Config_Init(void);
+// Saves the setting a config OUT report carries, for the next run; config
+// stays as it is. Returns false if it isn't one, or its value is out of
+// range.
+bool Config_Receive(const uint8_t* report, uint8_t size);
+#endif
+
+#endif
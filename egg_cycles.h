@@ -1,900 +1,510 @@
 #ifndef _EGG_CYCLES_H_
 #define _EGG_CYCLES_H_
 
-static const int egg_cycles[] = {
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    2560,
-    2560,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    2560,
-    2560,
-    5120,
-    5120,
-    2560,
-    2560,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    5120,
-    1280,
-    1280,
-    10240,
-    5120,
-    8960,
-    8960,
-    8960,
-    8960,
-    5120,
-    7680,
-    7680,
-    7680,
-    7680,
-    8960,
-    10240,
-    20480,
-    20480,
-    20480,
-    10240,
-    10240,
-    10240,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    2560,
-    2560,
-    2560,
-    2560,
-    2560,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    2560,
-    2560,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    8960,
-    8960,
-    5120,
-    5120,
-    6400,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    6400,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    5120,
-    10240,
-    20480,
-    20480,
-    20480,
-    10240,
-    10240,
-    10240,
-    30720,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    2560,
-    5120,
-    3840,
-    3840,
-    6400,
-    5120,
-    8960,
-    8960,
-    8960,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    7680,
-    7680,
-    7680,
-    7680,
-    5120,
-    5120,
-    6400,
-    5120,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    5120,
-    10240,
-    10240,
-    10240,
-    10240,
-    10240,
-    10240,
-    20480,
-    20480,
-    20480,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    7680,
-    7680,
-    7680,
-    7680,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    2560,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    7680,
-    7680,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    10240,
-    5120,
-    7680,
-    10240,
-    10240,
-    10240,
-    10240,
-    6400,
-    6400,
-    7680,
-    7680,
-    5120,
-    5120,
-    2560,
-    5120,
-    6400,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    2560,
-    5120,
-    8960,
-    8960,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    20480,
-    20480,
-    20480,
-    30720,
-    30720,
-    2560,
-    30720,
-    30720,
-    30720,
-    10240,
-    2560,
-    30720,
-    30720,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    5120,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    2560,
-    2560,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    6400,
-    6400,
-    7680,
-    7680,
-    7680,
-    7680,
-    5120,
-    5120,
-    6400,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    10240,
-    10240,
-    5120,
-    5120,
-    6400,
-    3840,
-    3840,
-    5120,
-    6400,
-    6400,
-    7680,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    10240,
-    10240,
-    10240,
-    10240,
-    10240,
-    20480,
-    20480,
-    20480,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    20480,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    7680,
-    7680,
-    7680,
-    7680,
-    8960,
-    5120,
-    5120,
-    6400,
-    10240,
-    10240,
-    10240,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    30720,
-    30720,
-    30720,
-    6400,
-    30720,
-    30720,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    30720,
-    30720,
-    6400,
-    5120,
-    5120,
-    2560,
-    5120,
-    3840,
-    5120,
-    6400,
-    10240,
-    10240,
-    10240,
-    3840,
-    3840,
-    3840,
-    3840,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    3840,
-    3840,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    5120,
-    3840,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    5120,
-    5120,
-    6400,
-    5120,
-    5120,
-    5120,
-    6400,
-    6400,
-    10240,
-    2560,
-    6400,
-    6400,
-    8960,
-    8960,
-    8960,
-    8960,
-    7680,
-    10240,
-    10240,
-    10240,
-    30720,
-    30720,
-    30720,
-    30720,
-    30720
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#if !defined(ARRAY_SIZE)
+    #define ARRAY_SIZE(x) (sizeof((x)) / sizeof((x)[0]))
+#endif
+
+// Every species uses one of a handful of egg cycle values (its cycle class)
+#define EGG_CYCLE_CLASSES(X) \
+    X(1280)  \
+    X(2560)  \
+    X(3840)  \
+    X(5120)  \
+    X(6400)  \
+    X(7680)  \
+    X(8960)  \
+    X(10240) \
+    X(20480) \
+    X(30720)
+
+// Cycle class IDs, in the same order as EGG_CYCLE_CLASSES
+#define CYCLE_CLASS_ID(cycles) CYCLES_##cycles,
+enum {
+    EGG_CYCLE_CLASSES(CYCLE_CLASS_ID)
+};
+
+// Egg cycle class of every species, indexed by National Pokedex number and
+// kept in flash. Each byte packs two 4-bit classes: the even dex number in
+// the low nibble and the odd one in the high nibble. Entry #0 is unused.
+// Use get_egg_cycle_class() to read it.
+#define PACK(even, odd) (uint8_t)(CYCLES_##even | (CYCLES_##odd << 4))
+static const uint8_t egg_cycle_class_index[] PROGMEM = {
+    PACK(30720, 5120),   // #0-1
+    PACK(5120, 5120),    // #2-3
+    PACK(5120, 5120),    // #4-5
+    PACK(5120, 5120),    // #6-7
+    PACK(5120, 5120),    // #8-9
+    PACK(3840, 3840),    // #10-11
+    PACK(3840, 3840),    // #12-13
+    PACK(3840, 3840),    // #14-15
+    PACK(3840, 3840),    // #16-17
+    PACK(3840, 3840),    // #18-19
+    PACK(3840, 3840),    // #20-21
+    PACK(3840, 5120),    // #22-23
+    PACK(5120, 2560),    // #24-25
+    PACK(2560, 5120),    // #26-27
+    PACK(5120, 5120),    // #28-29
+    PACK(5120, 5120),    // #30-31
+    PACK(5120, 5120),    // #32-33
+    PACK(5120, 2560),    // #34-35
+    PACK(2560, 5120),    // #36-37
+    PACK(5120, 2560),    // #38-39
+    PACK(2560, 3840),    // #40-41
+    PACK(3840, 5120),    // #42-43
+    PACK(5120, 5120),    // #44-45
+    PACK(5120, 5120),    // #46-47
+    PACK(5120, 5120),    // #48-49
+    PACK(5120, 5120),    // #50-51
+    PACK(5120, 5120),    // #52-53
+    PACK(5120, 5120),    // #54-55
+    PACK(5120, 5120),    // #56-57
+    PACK(5120, 5120),    // #58-59
+    PACK(5120, 5120),    // #60-61
+    PACK(5120, 5120),    // #62-63
+    PACK(5120, 5120),    // #64-65
+    PACK(5120, 5120),    // #66-67
+    PACK(5120, 5120),    // #68-69
+    PACK(5120, 5120),    // #70-71
+    PACK(5120, 5120),    // #72-73
+    PACK(3840, 3840),    // #74-75
+    PACK(3840, 5120),    // #76-77
+    PACK(5120, 5120),    // #78-79
+    PACK(5120, 5120),    // #80-81
+    PACK(5120, 5120),    // #82-83
+    PACK(5120, 5120),    // #84-85
+    PACK(5120, 5120),    // #86-87
+    PACK(5120, 5120),    // #88-89
+    PACK(5120, 5120),    // #90-91
+    PACK(5120, 5120),    // #92-93
+    PACK(5120, 6400),    // #94-95
+    PACK(5120, 5120),    // #96-97
+    PACK(5120, 5120),    // #98-99
+    PACK(5120, 5120),    // #100-101
+    PACK(5120, 5120),    // #102-103
+    PACK(5120, 5120),    // #104-105
+    PACK(6400, 6400),    // #106-107
+    PACK(5120, 5120),    // #108-109
+    PACK(5120, 5120),    // #110-111
+    PACK(5120, 10240),   // #112-113
+    PACK(5120, 5120),    // #114-115
+    PACK(5120, 5120),    // #116-117
+    PACK(5120, 5120),    // #118-119
+    PACK(5120, 5120),    // #120-121
+    PACK(6400, 6400),    // #122-123
+    PACK(6400, 6400),    // #124-125
+    PACK(6400, 6400),    // #126-127
+    PACK(5120, 1280),    // #128-129
+    PACK(1280, 10240),   // #130-131
+    PACK(5120, 8960),    // #132-133
+    PACK(8960, 8960),    // #134-135
+    PACK(8960, 5120),    // #136-137
+    PACK(7680, 7680),    // #138-139
+    PACK(7680, 7680),    // #140-141
+    PACK(8960, 10240),   // #142-143
+    PACK(20480, 20480),  // #144-145
+    PACK(20480, 10240),  // #146-147
+    PACK(10240, 10240),  // #148-149
+    PACK(30720, 30720),  // #150-151
+    PACK(5120, 5120),    // #152-153
+    PACK(5120, 5120),    // #154-155
+    PACK(5120, 5120),    // #156-157
+    PACK(5120, 5120),    // #158-159
+    PACK(5120, 3840),    // #160-161
+    PACK(3840, 3840),    // #162-163
+    PACK(3840, 3840),    // #164-165
+    PACK(3840, 3840),    // #166-167
+    PACK(3840, 3840),    // #168-169
+    PACK(5120, 5120),    // #170-171
+    PACK(2560, 2560),    // #172-173
+    PACK(2560, 2560),    // #174-175
+    PACK(2560, 5120),    // #176-177
+    PACK(5120, 5120),    // #178-179
+    PACK(5120, 5120),    // #180-181
+    PACK(5120, 2560),    // #182-183
+    PACK(2560, 5120),    // #184-185
+    PACK(5120, 5120),    // #186-187
+    PACK(5120, 5120),    // #188-189
+    PACK(5120, 5120),    // #190-191
+    PACK(5120, 5120),    // #192-193
+    PACK(5120, 5120),    // #194-195
+    PACK(8960, 8960),    // #196-197
+    PACK(5120, 5120),    // #198-199
+    PACK(6400, 10240),   // #200-201
+    PACK(5120, 5120),    // #202-203
+    PACK(5120, 5120),    // #204-205
+    PACK(5120, 5120),    // #206-207
+    PACK(6400, 5120),    // #208-209
+    PACK(5120, 5120),    // #210-211
+    PACK(6400, 5120),    // #212-213
+    PACK(6400, 5120),    // #214-215
+    PACK(5120, 5120),    // #216-217
+    PACK(5120, 5120),    // #218-219
+    PACK(5120, 5120),    // #220-221
+    PACK(5120, 5120),    // #222-223
+    PACK(5120, 5120),    // #224-225
+    PACK(6400, 6400),    // #226-227
+    PACK(5120, 5120),    // #228-229
+    PACK(5120, 5120),    // #230-231
+    PACK(5120, 5120),    // #232-233
+    PACK(5120, 5120),    // #234-235
+    PACK(6400, 6400),    // #236-237
+    PACK(6400, 6400),    // #238-239
+    PACK(6400, 5120),    // #240-241
+    PACK(10240, 20480),  // #242-243
+    PACK(20480, 20480),  // #244-245
+    PACK(10240, 10240),  // #246-247
+    PACK(10240, 30720),  // #248-249
+    PACK(30720, 30720),  // #250-251
+    PACK(5120, 5120),    // #252-253
+    PACK(5120, 5120),    // #254-255
+    PACK(5120, 5120),    // #256-257
+    PACK(5120, 5120),    // #258-259
+    PACK(5120, 3840),    // #260-261
+    PACK(3840, 3840),    // #262-263
+    PACK(3840, 3840),    // #264-265
+    PACK(3840, 3840),    // #266-267
+    PACK(3840, 3840),    // #268-269
+    PACK(3840, 3840),    // #270-271
+    PACK(3840, 3840),    // #272-273
+    PACK(3840, 3840),    // #274-275
+    PACK(3840, 3840),    // #276-277
+    PACK(5120, 5120),    // #278-279
+    PACK(5120, 5120),    // #280-281
+    PACK(5120, 3840),    // #282-283
+    PACK(3840, 3840),    // #284-285
+    PACK(3840, 3840),    // #286-287
+    PACK(3840, 3840),    // #288-289
+    PACK(3840, 3840),    // #290-291
+    PACK(3840, 5120),    // #292-293
+    PACK(5120, 5120),    // #294-295
+    PACK(5120, 5120),    // #296-297
+    PACK(2560, 5120),    // #298-299
+    PACK(3840, 3840),    // #300-301
+    PACK(6400, 5120),    // #302-303
+    PACK(8960, 8960),    // #304-305
+    PACK(8960, 5120),    // #306-307
+    PACK(5120, 5120),    // #308-309
+    PACK(5120, 5120),    // #310-311
+    PACK(5120, 3840),    // #312-313
+    PACK(3840, 5120),    // #314-315
+    PACK(5120, 5120),    // #316-317
+    PACK(5120, 5120),    // #318-319
+    PACK(10240, 10240),  // #320-321
+    PACK(5120, 5120),    // #322-323
+    PACK(5120, 5120),    // #324-325
+    PACK(5120, 3840),    // #326-327
+    PACK(5120, 5120),    // #328-329
+    PACK(5120, 5120),    // #330-331
+    PACK(5120, 5120),    // #332-333
+    PACK(5120, 5120),    // #334-335
+    PACK(5120, 6400),    // #336-337
+    PACK(6400, 5120),    // #338-339
+    PACK(5120, 3840),    // #340-341
+    PACK(3840, 5120),    // #342-343
+    PACK(5120, 7680),    // #344-345
+    PACK(7680, 7680),    // #346-347
+    PACK(7680, 5120),    // #348-349
+    PACK(5120, 6400),    // #350-351
+    PACK(5120, 6400),    // #352-353
+    PACK(6400, 6400),    // #354-355
+    PACK(6400, 6400),    // #356-357
+    PACK(6400, 6400),    // #358-359
+    PACK(5120, 5120),    // #360-361
+    PACK(5120, 5120),    // #362-363
+    PACK(5120, 5120),    // #364-365
+    PACK(5120, 5120),    // #366-367
+    PACK(5120, 10240),   // #368-369
+    PACK(5120, 10240),   // #370-371
+    PACK(10240, 10240),  // #372-373
+    PACK(10240, 10240),  // #374-375
+    PACK(10240, 20480),  // #376-377
+    PACK(20480, 20480),  // #378-379
+    PACK(30720, 30720),  // #380-381
+    PACK(30720, 30720),  // #382-383
+    PACK(30720, 30720),  // #384-385
+    PACK(30720, 5120),   // #386-387
+    PACK(5120, 5120),    // #388-389
+    PACK(5120, 5120),    // #390-391
+    PACK(5120, 5120),    // #392-393
+    PACK(5120, 5120),    // #394-395
+    PACK(3840, 3840),    // #396-397
+    PACK(3840, 3840),    // #398-399
+    PACK(3840, 3840),    // #400-401
+    PACK(3840, 5120),    // #402-403
+    PACK(5120, 5120),    // #404-405
+    PACK(5120, 5120),    // #406-407
+    PACK(7680, 7680),    // #408-409
+    PACK(7680, 7680),    // #410-411
+    PACK(3840, 3840),    // #412-413
+    PACK(3840, 3840),    // #414-415
+    PACK(3840, 2560),    // #416-417
+    PACK(5120, 5120),    // #418-419
+    PACK(5120, 5120),    // #420-421
+    PACK(5120, 5120),    // #422-423
+    PACK(5120, 7680),    // #424-425
+    PACK(7680, 5120),    // #426-427
+    PACK(5120, 6400),    // #428-429
+    PACK(5120, 5120),    // #430-431
+    PACK(5120, 6400),    // #432-433
+    PACK(5120, 5120),    // #434-435
+    PACK(5120, 5120),    // #436-437
+    PACK(5120, 6400),    // #438-439
+    PACK(10240, 5120),   // #440-441
+    PACK(7680, 10240),   // #442-443
+    PACK(10240, 10240),  // #444-445
+    PACK(10240, 6400),   // #446-447
+    PACK(6400, 7680),    // #448-449
+    PACK(7680, 5120),    // #450-451
+    PACK(5120, 2560),    // #452-453
+    PACK(5120, 6400),    // #454-455
+    PACK(5120, 5120),    // #456-457
+    PACK(6400, 5120),    // #458-459
+    PACK(5120, 5120),    // #460-461
+    PACK(5120, 5120),    // #462-463
+    PACK(5120, 5120),    // #464-465
+    PACK(6400, 6400),    // #466-467
+    PACK(2560, 5120),    // #468-469
+    PACK(8960, 8960),    // #470-471
+    PACK(5120, 5120),    // #472-473
+    PACK(5120, 5120),    // #474-475
+    PACK(5120, 6400),    // #476-477
+    PACK(5120, 5120),    // #478-479
+    PACK(20480, 20480),  // #480-481
+    PACK(20480, 30720),  // #482-483
+    PACK(30720, 2560),   // #484-485
+    PACK(30720, 30720),  // #486-487
+    PACK(30720, 10240),  // #488-489
+    PACK(2560, 30720),   // #490-491
+    PACK(30720, 30720),  // #492-493
+    PACK(30720, 5120),   // #494-495
+    PACK(5120, 5120),    // #496-497
+    PACK(5120, 5120),    // #498-499
+    PACK(5120, 5120),    // #500-501
+    PACK(5120, 5120),    // #502-503
+    PACK(3840, 5120),    // #504-505
+    PACK(3840, 3840),    // #506-507
+    PACK(3840, 5120),    // #508-509
+    PACK(5120, 5120),    // #510-511
+    PACK(5120, 5120),    // #512-513
+    PACK(5120, 5120),    // #514-515
+    PACK(5120, 2560),    // #516-517
+    PACK(2560, 3840),    // #518-519
+    PACK(3840, 3840),    // #520-521
+    PACK(5120, 5120),    // #522-523
+    PACK(3840, 3840),    // #524-525
+    PACK(3840, 3840),    // #526-527
+    PACK(3840, 5120),    // #528-529
+    PACK(5120, 5120),    // #530-531
+    PACK(5120, 5120),    // #532-533
+    PACK(5120, 5120),    // #534-535
+    PACK(5120, 5120),    // #536-537
+    PACK(5120, 5120),    // #538-539
+    PACK(3840, 3840),    // #540-541
+    PACK(3840, 3840),    // #542-543
+    PACK(3840, 5120),    // #544-545
+    PACK(5120, 5120),    // #546-547
+    PACK(5120, 5120),    // #548-549
+    PACK(10240, 5120),   // #550-551
+    PACK(5120, 5120),    // #552-553
+    PACK(5120, 5120),    // #554-555
+    PACK(5120, 5120),    // #556-557
+    PACK(5120, 3840),    // #558-559
+    PACK(3840, 5120),    // #560-561
+    PACK(6400, 6400),    // #562-563
+    PACK(7680, 7680),    // #564-565
+    PACK(7680, 7680),    // #566-567
+    PACK(5120, 5120),    // #568-569
+    PACK(6400, 5120),    // #570-571
+    PACK(3840, 3840),    // #572-573
+    PACK(5120, 5120),    // #574-575
+    PACK(5120, 5120),    // #576-577
+    PACK(5120, 5120),    // #578-579
+    PACK(5120, 5120),    // #580-581
+    PACK(5120, 5120),    // #582-583
+    PACK(5120, 5120),    // #584-585
+    PACK(5120, 5120),    // #586-587
+    PACK(3840, 3840),    // #588-589
+    PACK(5120, 5120),    // #590-591
+    PACK(5120, 5120),    // #592-593
+    PACK(10240, 5120),   // #594-595
+    PACK(5120, 5120),    // #596-597
+    PACK(5120, 5120),    // #598-599
+    PACK(5120, 5120),    // #600-601
+    PACK(5120, 5120),    // #602-603
+    PACK(5120, 5120),    // #604-605
+    PACK(5120, 5120),    // #606-607
+    PACK(5120, 5120),    // #608-609
+    PACK(10240, 10240),  // #610-611
+    PACK(10240, 5120),   // #612-613
+    PACK(5120, 6400),    // #614-615
+    PACK(3840, 3840),    // #616-617
+    PACK(5120, 6400),    // #618-619
+    PACK(6400, 7680),    // #620-621
+    PACK(6400, 6400),    // #622-623
+    PACK(5120, 5120),    // #624-625
+    PACK(5120, 5120),    // #626-627
+    PACK(5120, 5120),    // #628-629
+    PACK(5120, 5120),    // #630-631
+    PACK(5120, 10240),   // #632-633
+    PACK(10240, 10240),  // #634-635
+    PACK(10240, 10240),  // #636-637
+    PACK(20480, 20480),  // #638-639
+    PACK(20480, 30720),  // #640-641
+    PACK(30720, 30720),  // #642-643
+    PACK(30720, 30720),  // #644-645
+    PACK(30720, 20480),  // #646-647
+    PACK(30720, 30720),  // #648-649
+    PACK(5120, 5120),    // #650-651
+    PACK(5120, 5120),    // #652-653
+    PACK(5120, 5120),    // #654-655
+    PACK(5120, 5120),    // #656-657
+    PACK(5120, 3840),    // #658-659
+    PACK(3840, 3840),    // #660-661
+    PACK(3840, 3840),    // #662-663
+    PACK(3840, 3840),    // #664-665
+    PACK(3840, 5120),    // #666-667
+    PACK(5120, 5120),    // #668-669
+    PACK(5120, 5120),    // #670-671
+    PACK(5120, 5120),    // #672-673
+    PACK(6400, 6400),    // #674-675
+    PACK(5120, 5120),    // #676-677
+    PACK(5120, 5120),    // #678-679
+    PACK(5120, 5120),    // #680-681
+    PACK(5120, 5120),    // #682-683
+    PACK(5120, 5120),    // #684-685
+    PACK(5120, 5120),    // #686-687
+    PACK(5120, 5120),    // #688-689
+    PACK(5120, 5120),    // #690-691
+    PACK(3840, 3840),    // #692-693
+    PACK(5120, 5120),    // #694-695
+    PACK(7680, 7680),    // #696-697
+    PACK(7680, 7680),    // #698-699
+    PACK(8960, 5120),    // #700-701
+    PACK(5120, 6400),    // #702-703
+    PACK(10240, 10240),  // #704-705
+    PACK(10240, 5120),   // #706-707
+    PACK(5120, 5120),    // #708-709
+    PACK(5120, 5120),    // #710-711
+    PACK(5120, 5120),    // #712-713
+    PACK(5120, 5120),    // #714-715
+    PACK(30720, 30720),  // #716-717
+    PACK(30720, 6400),   // #718-719
+    PACK(30720, 30720),  // #720-721
+    PACK(3840, 3840),    // #722-723
+    PACK(3840, 3840),    // #724-725
+    PACK(3840, 3840),    // #726-727
+    PACK(3840, 3840),    // #728-729
+    PACK(3840, 3840),    // #730-731
+    PACK(3840, 3840),    // #732-733
+    PACK(3840, 3840),    // #734-735
+    PACK(3840, 3840),    // #736-737
+    PACK(3840, 5120),    // #738-739
+    PACK(5120, 5120),    // #740-741
+    PACK(5120, 5120),    // #742-743
+    PACK(3840, 3840),    // #744-745
+    PACK(3840, 5120),    // #746-747
+    PACK(5120, 5120),    // #748-749
+    PACK(5120, 3840),    // #750-751
+    PACK(3840, 5120),    // #752-753
+    PACK(5120, 5120),    // #754-755
+    PACK(5120, 5120),    // #756-757
+    PACK(5120, 3840),    // #758-759
+    PACK(3840, 5120),    // #760-761
+    PACK(5120, 5120),    // #762-763
+    PACK(5120, 5120),    // #764-765
+    PACK(5120, 5120),    // #766-767
+    PACK(5120, 3840),    // #768-769
+    PACK(3840, 3840),    // #770-771
+    PACK(30720, 30720),  // #772-773
+    PACK(6400, 5120),    // #774-775
+    PACK(5120, 2560),    // #776-777
+    PACK(5120, 3840),    // #778-779
+    PACK(5120, 6400),    // #780-781
+    PACK(10240, 10240),  // #782-783
+    PACK(10240, 3840),   // #784-785
+    PACK(3840, 3840),    // #786-787
+    PACK(3840, 30720),   // #788-789
+    PACK(30720, 30720),  // #790-791
+    PACK(30720, 30720),  // #792-793
+    PACK(30720, 30720),  // #794-795
+    PACK(30720, 30720),  // #796-797
+    PACK(30720, 30720),  // #798-799
+    PACK(30720, 30720),  // #800-801
+    PACK(30720, 30720),  // #802-803
+    PACK(30720, 30720),  // #804-805
+    PACK(30720, 30720),  // #806-807
+    PACK(30720, 30720),  // #808-809
+    PACK(5120, 5120),    // #810-811
+    PACK(5120, 5120),    // #812-813
+    PACK(5120, 5120),    // #814-815
+    PACK(5120, 5120),    // #816-817
+    PACK(5120, 5120),    // #818-819
+    PACK(5120, 3840),    // #820-821
+    PACK(3840, 3840),    // #822-823
+    PACK(3840, 3840),    // #824-825
+    PACK(3840, 3840),    // #826-827
+    PACK(3840, 5120),    // #828-829
+    PACK(5120, 3840),    // #830-831
+    PACK(3840, 5120),    // #832-833
+    PACK(5120, 5120),    // #834-835
+    PACK(5120, 3840),    // #836-837
+    PACK(3840, 3840),    // #838-839
+    PACK(5120, 5120),    // #840-841
+    PACK(5120, 5120),    // #842-843
+    PACK(5120, 5120),    // #844-845
+    PACK(5120, 5120),    // #846-847
+    PACK(6400, 6400),    // #848-849
+    PACK(5120, 5120),    // #850-851
+    PACK(6400, 6400),    // #852-853
+    PACK(5120, 5120),    // #854-855
+    PACK(5120, 5120),    // #856-857
+    PACK(5120, 5120),    // #858-859
+    PACK(5120, 5120),    // #860-861
+    PACK(3840, 5120),    // #862-863
+    PACK(5120, 5120),    // #864-865
+    PACK(6400, 6400),    // #866-867
+    PACK(5120, 5120),    // #868-869
+    PACK(6400, 5120),    // #870-871
+    PACK(5120, 5120),    // #872-873
+    PACK(6400, 6400),    // #874-875
+    PACK(10240, 2560),   // #876-877
+    PACK(6400, 6400),    // #878-879
+    PACK(8960, 8960),    // #880-881
+    PACK(8960, 8960),    // #882-883
+    PACK(7680, 10240),   // #884-885
+    PACK(10240, 10240),  // #886-887
+    PACK(30720, 30720),  // #888-889
+    PACK(30720, 30720),  // #890-891
+    PACK(30720, 30720)   // #892 (odd half is padding)
+};
+
+#define LAST_DEX_NUMBER 892
+
+#define CYCLE_CLASS_VALUE(cycles) cycles,
+static const uint16_t egg_cycle_classes[] PROGMEM = {
+    EGG_CYCLE_CLASSES(CYCLE_CLASS_VALUE)
+};
+
+// Hatch time model: how many reports to circle before the eggs hatch.
+// It's a linear fit of 1.046 reports per egg cycle minus 32.583 reports,
+// kept in thousandths so the compiler can work it out in integer math.
+// Flame Body (and friends) halves the egg cycles.
+#define HATCH_SLOPE_MILLI  1046L
+#define HATCH_OFFSET_MILLI 32583L
+#define HATCH_REPORTS(cycles) \
+    (uint16_t)((HATCH_SLOPE_MILLI * (cycles) - HATCH_OFFSET_MILLI) / 1000)
+
+#define HATCH_REPORTS_NORMAL(cycles)     HATCH_REPORTS(cycles),
+#define HATCH_REPORTS_FLAME_BODY(cycles) HATCH_REPORTS((cycles) / 2),
+
+// Indexed by [flame_body][cycle class]
+static const uint16_t breeding_durations[2][ARRAY_SIZE(egg_cycle_classes)] PROGMEM = {
+    { EGG_CYCLE_CLASSES(HATCH_REPORTS_NORMAL) },
+    { EGG_CYCLE_CLASSES(HATCH_REPORTS_FLAME_BODY) }
 };
 
 #endif
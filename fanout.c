@@ -0,0 +1,82 @@
+#include <avr/io.h>
+#include <util/atomic.h>
+#include <string.h>
+
+#include "fanout.h"
+#include "serial.h"
+#include "timer.h"
+
+#if defined(FANOUT_LEADER) || defined(FANOUT_FOLLOWER)
+
+// The console number, then its report
+#define PAYLOAD_SIZE (FANOUT_REPORT_SIZE + 1)
+
+#ifdef FANOUT_LEADER
+// Every follower gets a frame every poll, and they all have to fit in the
+// queue at once, or some would never hear from the leader and let go of
+// everything. Joystick.c checks they go out in time for the next poll.
+_Static_assert(FANOUT_CONSOLES >= 2 && FANOUT_CONSOLES - 1 <= FANOUT_ID_MASK + 1,
+	"the console number straps only number 8 followers");
+_Static_assert((FANOUT_CONSOLES - 1) * FANOUT_FRAME_SIZE < SERIAL_OUTPUT_SIZE,
+	"too many consoles for the serial queue, 7 at most");
+#endif
+
+#ifdef FANOUT_FOLLOWER
+static void receive(const uint8_t* payload);
+#endif
+
+void Fanout_Init(void) {
+	#ifdef FANOUT_LEADER
+	Serial_Init(FANOUT_BAUD, FANOUT_SYNC, PAYLOAD_SIZE, NULL);
+	#else
+	// Console number straps, with pull-ups
+	FANOUT_ID_DDR  &= ~FANOUT_ID_MASK;
+	FANOUT_ID_PORT |=  FANOUT_ID_MASK;
+	Serial_Init(FANOUT_BAUD, FANOUT_SYNC, PAYLOAD_SIZE, receive);
+	#endif
+}
+
+#ifdef FANOUT_LEADER
+// Every follower gets a frame every poll, so one that finds the queue full
+// is dropped and its follower holds its report a poll longer
+void Fanout_Send(uint8_t console, const uint8_t* report) {
+	uint8_t payload[PAYLOAD_SIZE];
+
+	payload[0] = console;
+	memcpy(&payload[1], report, FANOUT_REPORT_SIZE);
+	Serial_Send_Frame(FANOUT_SYNC, payload, PAYLOAD_SIZE);
+}
+#endif
+
+#ifdef FANOUT_FOLLOWER
+// The newest report for this console, nothing pressed with the HAT and
+// sticks centred until the first, and when it came
+static volatile uint8_t received[FANOUT_REPORT_SIZE] = NEUTRAL_REPORT;
+static volatile uint32_t received_ms = 0;
+
+void Fanout_Get(uint8_t* report) {
+	static const uint8_t neutral[FANOUT_REPORT_SIZE] = NEUTRAL_REPORT;
+	uint32_t last_ms;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		memcpy(report, (const uint8_t*)received, FANOUT_REPORT_SIZE);
+		last_ms = received_ms;
+	}
+
+	// Don't hold a button down on the Switch if the leader's gone quiet
+	if (timer_reached(last_ms + FANOUT_TIMEOUT_MS))
+		memcpy(report, neutral, FANOUT_REPORT_SIZE);
+}
+
+// Takes this console's reports, from the receive interrupt
+static void receive(const uint8_t* payload) {
+	if (payload[0] != (~FANOUT_ID_PIN & FANOUT_ID_MASK) + 1)
+		return;
+
+	memcpy((uint8_t*)received, &payload[1], FANOUT_REPORT_SIZE);
+	received_ms = get_time_ms();
+}
+#endif
+
+#endif
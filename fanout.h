@@ -0,0 +1,57 @@
+#ifndef _FANOUT_H_
+#define _FANOUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fan-out: one leader board runs the bot for several consoles at once. The
+// leader drives its own Switch over USB as usual and works out every other
+// console's reports alongside, from the same settings. It sends those over
+// its serial port to follower boards, one per console, which pass them on
+// to their Switch. The leader's TX goes to every follower's RX, and each
+// follower picks out its own reports by console number.
+//
+// "make fanout-leader" takes FANOUT_CONSOLES (2 by default, the leader's own
+// console included) and FANOUT_OFFSET_MS, how much later each console starts
+// than the one before. "make fanout-follower" reads its console number from
+// PB0-PB2: leave them all open for console 1, ground PB0 for console 2 and
+// so on.
+//
+// How many consoles there can be is limited by the straps (8 followers), the
+// serial queue (6 followers) and getting every follower a frame each poll
+// (2 followers at 1 ms polling, 5 at 2 ms, 6 at 3 ms or more), all checked
+// when the leader is built. SRAM is the tighter limit on the 16u2: each
+// console after the first takes about 55 bytes of its 512, which leaves
+// room for 3 consoles. An atmega32u4 (MCU = atmega32u4, 2.5 KB) has room
+// for as many as the serial port allows.
+//
+// Frames are FANOUT_SYNC, the console number, the report (Button low byte,
+// Button high byte, HAT, LX, LY, RX, RY), then the low byte of the sum of
+// the console number and report.
+#define FANOUT_BAUD        250000
+#define FANOUT_SYNC        0x5A
+#define FANOUT_REPORT_SIZE 7
+#define FANOUT_FRAME_SIZE  (FANOUT_REPORT_SIZE + 3)
+
+#ifndef FANOUT_CONSOLES
+	#define FANOUT_CONSOLES 2
+#endif
+#ifndef FANOUT_OFFSET_MS
+	#define FANOUT_OFFSET_MS 0
+#endif
+
+// A follower that hears nothing for this long lets go of everything
+#define FANOUT_TIMEOUT_MS  100
+
+#define FANOUT_ID_PIN      PINB
+#define FANOUT_ID_DDR      DDRB
+#define FANOUT_ID_PORT     PORTB
+#define FANOUT_ID_MASK     0x07
+
+void Fanout_Init(void);
+// Leader: queues a report for a follower's console
+void Fanout_Send(uint8_t console, const uint8_t* report);
+// Follower: copies out the report to pass on
+void Fanout_Get(uint8_t* report);
+
+#endif
@@ -0,0 +1,72 @@
+#include <avr/io.h>
+
+#include "feedback.h"
+#include "timer.h"
+
+uint8_t hatch_count = 0;
+uint32_t last_hatch_ms = 0;
+uint8_t eggs_received = 0;
+bool target_found = false;
+uint32_t target_found_ms = 0;
+
+static void record_hatch(void) {
+	hatch_count++;
+	last_hatch_ms = get_time_ms();
+}
+
+static void record_target(void) {
+	if (target_found)
+		return;
+
+	target_found = true;
+	target_found_ms = get_time_ms();
+}
+
+// Sets up whichever feedback inputs were built in.
+void Feedback_Init(void) {
+	#ifdef HATCH_SENSOR
+	// Input with pull-up, even if ALERT_WHEN_DONE made the whole port an output.
+	HATCH_SENSOR_DDR  &= ~(1 << HATCH_SENSOR_BIT);
+	HATCH_SENSOR_PORT |=  (1 << HATCH_SENSOR_BIT);
+	#endif
+
+	#ifdef TARGET_PIN
+	TARGET_PIN_DDR  &= ~(1 << TARGET_PIN_BIT);
+	TARGET_PIN_PORT |=  (1 << TARGET_PIN_BIT);
+	#endif
+
+	#ifdef SERIAL_FEEDBACK
+	UBRR1  = (F_CPU / 16 / FEEDBACK_BAUD) - 1;
+	UCSR1B = (1 << RXEN1);
+	UCSR1C = (1 << UCSZ11) | (1 << UCSZ10);
+	#endif
+}
+
+void Feedback_Task(void) {
+	#ifdef HATCH_SENSOR
+	if (!(HATCH_SENSOR_PIN & (1 << HATCH_SENSOR_BIT)))
+	{
+		if (timer_reached(last_hatch_ms + HATCH_SENSOR_HOLDOFF_MS))
+			record_hatch();
+	}
+	#endif
+
+	#ifdef TARGET_PIN
+	if (!(TARGET_PIN_PIN & (1 << TARGET_PIN_BIT)))
+		record_target();
+	#endif
+
+	#ifdef SERIAL_FEEDBACK
+	while (UCSR1A & (1 << RXC1))
+	{
+		uint8_t event = UDR1;
+
+		if (event == FEEDBACK_HATCH)
+			record_hatch();
+		else if (event == FEEDBACK_EGG)
+			eggs_received++;
+		else if (event == FEEDBACK_TARGET)
+			record_target();
+	}
+	#endif
+}
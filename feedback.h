@@ -0,0 +1,56 @@
+#ifndef _FEEDBACK_H_
+#define _FEEDBACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Optional closed-loop feedback from the console. Events come from a light
+// sensor on a spare pin (HATCH_SENSOR, "make with-hatch-sensor") and/or as
+// bytes on the 16u2's serial port, e.g. sent by a capture card host
+// (SERIAL_FEEDBACK, "make with-serial-feedback").
+#if defined(HATCH_SENSOR) || defined(SERIAL_FEEDBACK)
+	#define FEEDBACK_ENABLED
+#endif
+
+// Whatever's watching the hatches can also say one of them was the target
+// (a shiny, say), to end the run there: a switch or output pulling PB5 low
+// (TARGET_PIN, "make with-target-pin"), or a byte on the serial port.
+#if defined(SERIAL_FEEDBACK) || defined(TARGET_PIN)
+	#define TARGET_TRIGGER
+#endif
+
+// The light sensor pulls PB4 low while the screen flashes for a hatch.
+// A hatch flashes more than once, so the sensor is ignored for a while
+// after each one.
+#define HATCH_SENSOR_PIN        PINB
+#define HATCH_SENSOR_DDR        DDRB
+#define HATCH_SENSOR_PORT       PORTB
+#define HATCH_SENSOR_BIT        4
+#define HATCH_SENSOR_HOLDOFF_MS 5000
+
+#define TARGET_PIN_PIN          PINB
+#define TARGET_PIN_DDR          DDRB
+#define TARGET_PIN_PORT         PORTB
+#define TARGET_PIN_BIT          5
+
+// Serial feedback runs at 9600 8N1, one byte per event
+#define FEEDBACK_BAUD           9600
+#define FEEDBACK_HATCH          'H'
+#define FEEDBACK_EGG            'E'
+#define FEEDBACK_TARGET         'T'
+
+// Hatches seen since the count was last reset, and when the latest was
+extern uint8_t hatch_count;
+extern uint32_t last_hatch_ms;
+// Eggs the nursery worker has handed over since GetNextReport() last
+// took them, as seen by serial feedback
+extern uint8_t eggs_received;
+// Set once the target has hatched, and stays set, and when that was
+extern bool target_found;
+extern uint32_t target_found_ms;
+
+void Feedback_Init(void);
+// Samples the sensor and serial port, call it regularly.
+void Feedback_Task(void);
+
+#endif
@@ -29,296 +29,447 @@ typedef enum {
     L_left_slight,
     L_right_slight,
     L_up_slight,
-    L_down_slight
+    L_down_slight,
+
+    // A whole report, carried in the step itself (see RAW_STEP())
+    raw_report,
+
+    // Control codes, handled by do_steps() instead of take_action()
+    set_echoes,
+    call
 } action_t;
 
+// Each step is packed into a single byte: the action in the upper five bits
+// and the duration in the lower three. Durations up to SHORT_DURATION_MAX fit
+// inline. Longer ones store DURATION_ESCAPE inline and the real duration in
+// the byte that follows, so use STEP() for short steps and LONG_STEP() for
+// long ones. STEP() refuses to compile if the duration doesn't fit.
+typedef uint8_t command_t;
+
+#define SHORT_DURATION_MAX 6
+#define DURATION_ESCAPE    7
+
+#define STEP(action, duration) \
+    (command_t)(((action) << 3) | (duration)) + 0 * sizeof(char[((duration) <= SHORT_DURATION_MAX && (action) < 32) ? 1 : -1])
+#define LONG_STEP(action, duration) \
+    (command_t)(((action) << 3) | DURATION_ESCAPE), (command_t)(duration)
+
+// A step can also hold any report, not just one of the actions: a long step
+// of raw_report followed by the report's bytes, in the order they go out
+// (Button low byte first). "make recorder" writes traces in this form.
+#define RAW_REPORT_SIZE 7
+#define RAW_STEP(duration, button, hat, lx, ly, rx, ry) \
+    LONG_STEP(raw_report, duration), \
+    (command_t)((button) & 0xFF), (command_t)((button) >> 8), \
+    (command_t)(hat), (command_t)(lx), (command_t)(ly), (command_t)(rx), (command_t)(ry)
+
+// Steps are timed off the millisecond clock, not by counting polls, so the
+// USB polling interval doesn't change them. A step lasts (duration + 1)
+// logical reports, each REPORT_MS(echoes) long: what it took at the 5 ms
+// polling interval every table was originally tuned at.
+#define REFERENCE_INTERVAL_MS 5
+#define REPORT_MS(echoes) (((echoes) + 1) * REFERENCE_INTERVAL_MS)
+
+// How long CIRCLE1 walks around waiting for an egg, and how long CIRCLE_CW
+// keeps going past the hatch model so the hatch animations can play out
+#define CIRCLE1_MS       5265
+#define HATCH_PADDING_MS 63000UL
+
+// With hatch feedback, CIRCLE_CW stops once all the eggs it carries have
+// hatched, after giving the last hatch time to play out
+#define EGGS_PER_COLUMN  5
+#define HATCH_SETTLE_MS  15000UL
+
+// With egg feedback, collecting stops once there are enough for a box
+#define EGGS_PER_BOX     (6 * EGGS_PER_COLUMN)
+
+// With the watchdog build, the bot backs out of any menus before flying back
+// to the nursery once every RESYNC_COLUMNS columns, and straight away when
+// feedback shows it has lost its place: a column circled without a single
+// hatch, or DRY_CHECKS egg checks in a row without an egg
+#define RESYNC_COLUMNS   6
+#define DRY_CHECKS       6
+
+// Long waits (hang steps longer than SHORT_DURATION_MAX) are for menus,
+// text and loading, which take longer on some consoles than others. The
+// timing profile scales them, as a percentage of the tested timings. Short
+// hangs are gaps between inputs, which only depend on the game, so they're
+// left alone. Indexed by timing_profile.
 typedef struct {
-    action_t action;
-    uint8_t duration;
-} command_t;
-
-static const command_t wake_up_hang[] = {
-    { hang,  50 }
-};
-
-static const command_t fly_to_breading_steps[] = {
-    { press_a, 5 },
-    { hang, 50 },
-    { press_x, 7},
-    { hang, 35 },
-    { press_plus, 5 },
-    { hang, 90 },
-    { L_up_right_slight, 2 },
-    { hang, 5 },
-    { press_a, 5 },
-    { hang, 25 },
-    { press_a, 5 },
-    { hang, 90 }
-};
-
-static const command_t go_in_out_nursery[] = {
-    { L_up_slight, 5 },
-    { hang, 5 },
-    { L_up, 20 },
-    { hang, 100 },
-    { L_down, 15 },
-    { hang, 80 },
-    { press_plus, 5 },
-    { hang, 10 }
-};
-
-static const command_t go_to_circle1[] = {
-    { L_left_slight, 5 },
-    { hang, 5 },
-    { L_left, 28 },
-    { hang, 20 }
-};
-
-static const command_t go_to_circle2[] = {
-    { L_left_slight, 5 },
-    { hang, 5 },
-    { L_left, 13 },
-    { hang, 20 }
-};
-
-static const command_t go_to_circle3[] = {
-    { L_down_slight, 7 },
-    { hang, 5 },
-    { L_down, 7 },
-    { hang, 15 },
-    { L_left_slight, 5 },
-    { hang, 5 },
-    { L_left, 45 },
-    { hang, 15 },
-    { L_right_slight, 5},
-    { hang, 5 }
-};
-
-static const command_t approach[] = {
-    { hang, 20 },
-    { L_right_slight, 5 },
-    { hang, 10 },
-    { L_up_right, 70 },
-    { hang, 5 },
-};
-
-static const command_t speak[] = {
-    { press_a, 5 },
-    { hang, 30 },
-    { press_a, 5 },
-    { hang, 30 },
-    { L_down, 5 },
-    { hang, 5 },
-    { L_down, 5},
-    { hang, 10 },
-    { press_a, 5 },
-    { hang, 140 },
-    { press_b, 5 },
-    { hang, 75 },
-    { press_b, 5 },
-    { hang, 60 },
-    { press_b, 5 },
-    { hang, 20 }
-};
-
-static const command_t open_box[] = {
-    { hang, 40 },
-    { press_x, 5},
-    { hang, 35 },
-    { press_a, 5 },
-    { hang, 60 },
-    { press_r, 5 },
-    { hang, 75 },
-    { press_y, 3 },
-    { hang, 3 },
-    { press_y, 3 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t select_col[] = {
-    { press_a, 3 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 10 }
-};
-
-static const command_t close_box[] = {
-    { press_a, 3 },
-    { hang, 3 },
-    { press_b, 3 },
-    { hang, 75 },
-    { press_b, 3 },
-    { hang, 60 },
-    { press_x, 3 },
-    { hang, 35 } 
-};
-
-static const command_t grab_eggs1_pre[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_up, 1 },
-    { hang, 5 },
-    { press_l, 5 },
-    { hang, 10 },
-    { press_a, 1 },
-    { hang, 5 },
-    { press_r, 5 },
-    { hang, 10 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs1_post[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs2_pre[] = {
-    { L_right, 1 },
-    { hang, 3 },
-    { L_up, 3 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs2_post[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs3_pre[] = {
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_up, 3 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs3_post[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs4_pre[] = {
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_up, 1 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs4_post[] = {
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs5_pre[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_up, 1 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs5_post[] = {
-    { L_right, 1 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs6_pre[] = {
-    { L_left, 1 },
-    { hang, 3 },
-    { L_left, 1 },
-    { hang, 3 },
-    { L_up, 1 },
-    { hang, 3 },
-    { press_a, 3 },
-    { hang, 3 },
-    { L_right, 1 },
-    { hang, 1 }
-};
-
-static const command_t grab_eggs6_post[] = {
-    { press_r, 5 },
-    { hang, 5 },
-    { L_right, 1 },
-    { hang, 3 },
-    { L_down, 1 },
-    { hang, 1 }
-};
-
-static const command_t save_game[] = {
-    { hang, 40 },
-    { press_x, 5},
-    { hang, 35 },
-    { press_r, 5 },
-    { hang, 75 },
-    { press_a, 3 },
-    { hang, 100 }
-};
-
-static const command_t sleep[] = {
-    { press_home, 25 },
-    { hang, 5 },
-    { press_a, 5 }
+    uint8_t wait_percent;
+} timing_profile_t;
+
+static const timing_profile_t timing_profiles[] PROGMEM = {
+    { 100 },    // Standard
+    { 85 },     // Quick
+    { 130 }     // Patient
+};
+
+// Each logical report lasts as long as ECHOES + 1 polls by default, which
+// debounces menu transitions. A SET_ECHOES() step changes that for the rest
+// of its table and takes no time itself; every table starts at ECHOES.
+// It mustn't be the last step of a table.
+#define ECHOES 2
+#define SET_ECHOES(echoes) STEP(set_echoes, echoes)
+
+// Steps shared between tables live in fragments, which a table runs with
+// CALL(), or CALL_TIMES() to run one up to 8 times over. A call takes no time
+// itself. A fragment starts at ECHOES like any table, and the caller's
+// echoes are back in force once it returns. Fragments can call fragments,
+// CALL_DEPTH deep. A fragment is named after its table, without the _steps.
+#define CALL_DEPTH 2
+#define CALL_TIMES(fragment, times) \
+    (command_t)((call << 3) | ((times) - 1)) + 0 * sizeof(char[((times) >= 1 && (times) <= 8) ? 1 : -1]), \
+    (command_t)(fragment_##fragment)
+#define CALL(fragment) CALL_TIMES(fragment, 1)
+
+// Indexes fragments[], further down
+typedef enum {
+    fragment_x_menu,
+    fragment_nudge_left,
+    fragment_menu_up,
+    fragment_box_down,
+    fragment_box_drop,
+    FRAGMENT_COUNT
+} fragment_t;
+
+// Timings for box cursor moves at SET_ECHOES(0): hold and release for 7
+// reports each, enough for the game to see both at 30 fps.
+#define FAST_HOLD    6
+#define FAST_RELEASE 6
+
+// All step tables live in flash (PROGMEM) so they don't take up SRAM.
+// They can't be dereferenced directly; do_steps() decodes them one byte at a
+// time with pgm_read_byte().
+
+// Opens the X menu from the overworld
+static const command_t x_menu_steps[] PROGMEM = {
+    LONG_STEP(hang, 40),
+    STEP(press_x, 5),
+    LONG_STEP(hang, 35)
+};
+
+// Turns to face left before walking that way
+static const command_t nudge_left_steps[] PROGMEM = {
+    STEP(L_left_slight, 5),
+    STEP(hang, 5)
+};
+
+// One menu entry up
+static const command_t menu_up_steps[] PROGMEM = {
+    STEP(L_up, 5),
+    STEP(hang, 5)
 };
 
+static const command_t wake_up_hang[] PROGMEM = {
+    LONG_STEP(hang, 50)
+};
+
+static const command_t fly_to_breading_steps[] PROGMEM = {
+    STEP(press_a, 5),
+    LONG_STEP(hang, 50),
+    LONG_STEP(press_x, 7),
+    LONG_STEP(hang, 35),
+    STEP(press_plus, 5),
+    LONG_STEP(hang, 90),
+    STEP(L_up_right_slight, 2),
+    STEP(hang, 5),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 25),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 90)
+};
+
+#ifdef WATCHDOG
+// B closes menus and the box, and clears text, wherever the game has got to,
+// and does nothing in the overworld. Enough for the box, which is three
+// menus deep.
+static const command_t resync_steps[] PROGMEM = {
+    STEP(press_b, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 75)
+};
+#endif
+
+static const command_t go_in_out_nursery[] PROGMEM = {
+    STEP(L_up_slight, 5),
+    STEP(hang, 5),
+    LONG_STEP(L_up, 20),
+    LONG_STEP(hang, 100),
+    LONG_STEP(L_down, 15),
+    LONG_STEP(hang, 80),
+    STEP(press_plus, 5),
+    LONG_STEP(hang, 10)
+};
+
+static const command_t go_to_circle1[] PROGMEM = {
+    CALL(nudge_left),
+    LONG_STEP(L_left, 28),
+    LONG_STEP(hang, 20)
+};
+
+static const command_t go_to_circle2[] PROGMEM = {
+    CALL(nudge_left),
+    LONG_STEP(L_left, 13),
+    LONG_STEP(hang, 20)
+};
+
+static const command_t go_to_circle3[] PROGMEM = {
+    LONG_STEP(L_down_slight, 7),
+    STEP(hang, 5),
+    LONG_STEP(L_down, 7),
+    LONG_STEP(hang, 15),
+    CALL(nudge_left),
+    LONG_STEP(L_left, 45),
+    LONG_STEP(hang, 15),
+    STEP(L_right_slight, 5),
+    STEP(hang, 5)
+};
+
+static const command_t approach[] PROGMEM = {
+    LONG_STEP(hang, 20),
+    STEP(L_right_slight, 5),
+    LONG_STEP(hang, 10),
+    LONG_STEP(L_up_right, 70),
+    STEP(hang, 5),
+};
+
+static const command_t speak[] PROGMEM = {
+    STEP(press_a, 5),
+    LONG_STEP(hang, 30),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 30),
+    STEP(L_down, 5),
+    STEP(hang, 5),
+    STEP(L_down, 5),
+    LONG_STEP(hang, 10),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 140),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 60),
+    STEP(press_b, 5),
+    LONG_STEP(hang, 20)
+};
+
+static const command_t open_box[] PROGMEM = {
+    CALL(x_menu),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 60),
+    STEP(press_r, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_y, 3),
+    STEP(hang, 3),
+    STEP(press_y, 3),
+    STEP(hang, 3),
+    STEP(L_left, 1),
+    STEP(hang, 3),
+    STEP(L_down, 1),
+    STEP(hang, 1)
+};
+
+static const command_t select_col[] PROGMEM = {
+    CALL(box_drop),
+    CALL_TIMES(box_down, 4),
+    SET_ECHOES(0),
+    STEP(press_a, FAST_HOLD),
+    SET_ECHOES(ECHOES),
+    LONG_STEP(hang, 10)
+};
+
+static const command_t close_box[] PROGMEM = {
+    STEP(press_a, 3),
+    STEP(hang, 3),
+    STEP(press_b, 3),
+    LONG_STEP(hang, 75),
+    STEP(press_b, 3),
+    LONG_STEP(hang, 60),
+    STEP(press_x, 3),
+    LONG_STEP(hang, 35)
+};
+
+// Box cursor moves. GRAB_EGGS_PRE/POST work out which ones each column
+// needs from egg_set, so there's no table per column.
+typedef enum {
+    box_left,
+    box_right,
+    box_up,
+    box_down,
+    box_drop,
+    box_prev,
+    box_next,
+    box_cursor,
+    box_release
+} box_move_t;
+
+static const command_t box_left_steps[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(L_left, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+
+static const command_t box_right_steps[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(L_right, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+
+static const command_t box_up_steps[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(L_up, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+
+static const command_t box_down_steps[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(L_down, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+
+static const command_t box_drop_steps[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(press_a, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+
+// Switching boxes plays an animation, so these go at the normal pace
+static const command_t box_prev_steps[] PROGMEM = {
+    STEP(press_l, 5),
+    LONG_STEP(hang, 10)
+};
+
+static const command_t box_next_steps[] PROGMEM = {
+    STEP(press_r, 5),
+    LONG_STEP(hang, 10)
+};
+
+// Y steps through the cursor modes: normal, swap, then multi-select
+static const command_t box_cursor_steps[] PROGMEM = {
+    STEP(press_y, 3),
+    STEP(hang, 3)
+};
+
+// Releases the Pokemon under the normal cursor: Release is second from the
+// bottom of its menu, and the confirmation defaults to No
+static const command_t box_release_steps[] PROGMEM = {
+    STEP(press_a, 5),
+    LONG_STEP(hang, 20),
+    CALL_TIMES(menu_up, 2),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 40),
+    CALL(menu_up),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 60),
+    STEP(press_a, 5),
+    LONG_STEP(hang, 20)
+};
+
+// A step table and its size, for picking tables at runtime
+typedef struct {
+    const command_t* steps;
+    uint8_t size;
+} step_table_t;
+
+#define STEP_TABLE(steps) { steps, ARRAY_SIZE(steps) }
+
+// Indexed by box_move_t
+static const step_table_t box_moves[] PROGMEM = {
+    STEP_TABLE(box_left_steps),
+    STEP_TABLE(box_right_steps),
+    STEP_TABLE(box_up_steps),
+    STEP_TABLE(box_down_steps),
+    STEP_TABLE(box_drop_steps),
+    STEP_TABLE(box_prev_steps),
+    STEP_TABLE(box_next_steps),
+    STEP_TABLE(box_cursor_steps),
+    STEP_TABLE(box_release_steps)
+};
+
+// Indexed by fragment_t. The box moves double as fragments.
+static const step_table_t fragments[] PROGMEM = {
+    STEP_TABLE(x_menu_steps),
+    STEP_TABLE(nudge_left_steps),
+    STEP_TABLE(menu_up_steps),
+    STEP_TABLE(box_down_steps),
+    STEP_TABLE(box_drop_steps)
+};
+
+static const command_t save_game[] PROGMEM = {
+    CALL(x_menu),
+    STEP(press_r, 5),
+    LONG_STEP(hang, 75),
+    STEP(press_a, 3),
+    LONG_STEP(hang, 100)
+};
+
+static const command_t sleep[] PROGMEM = {
+    LONG_STEP(press_home, 25),
+    STEP(hang, 5),
+    STEP(press_a, 5)
+};
+
+// Stick patterns for the circling states. The left stick goes round a circle
+// of the given radius once a lap, with `press` tapped for press_ms out of
+// every press_every_ms on top. Angles are in 64ths of a turn, counting
+// anticlockwise from right as seen on screen.
+#define PATTERN_STEPS 64
+
+typedef struct {
+    uint16_t lap_ms;
+    uint8_t  radius;          // Stick deflection, up to 127
+    uint8_t  start;           // Angle at the start of a lap
+    int8_t   turn;            // 1 = anticlockwise, -1 = clockwise
+    uint8_t  press;           // action_t to tap, or hang for none
+    uint16_t press_every_ms;
+    uint16_t press_ms;
+} pattern_t;
+
+// sin() of each angle, scaled to 127
+static const int8_t sine_table[PATTERN_STEPS] PROGMEM = {
+    0, 12, 25, 37, 49, 60, 71, 81,
+    90, 98, 106, 112, 117, 122, 125, 126,
+    127, 126, 125, 122, 117, 112, 106, 98,
+    90, 81, 71, 60, 49, 37, 25, 12,
+    0, -12, -25, -37, -49, -60, -71, -81,
+    -90, -98, -106, -112, -117, -122, -125, -126,
+    -127, -126, -125, -122, -117, -112, -106, -98,
+    -90, -81, -71, -60, -49, -37, -25, -12
+};
+
+// Both laps take as long as the old 48-report square ones did, and
+// CIRCLE_CW still taps A for 6 reports out of every 24 to hatch eggs.
+// Going round a true circle at full tilt is also a little quicker in game
+// than the square was.
+#define CIRCLE_LAP_MS (48 * REPORT_MS(ECHOES))
+
+// Anticlockwise from the left
+static const pattern_t circle1_pattern PROGMEM = {
+    CIRCLE_LAP_MS, 127, PATTERN_STEPS / 2, 1, hang, 0, 0
+};
+
+// Clockwise from the right, mashing A
+static const pattern_t circle_cw_pattern PROGMEM = {
+    CIRCLE_LAP_MS, 127, 0, -1, press_a, 24 * REPORT_MS(ECHOES), 6 * REPORT_MS(ECHOES)
+};
+
+#ifdef REPORT_RATE_BENCHMARK
+// Taps right as fast as the game can see it. Leave a menu or the keyboard
+// open to check the Switch registers every input at this polling interval.
+static const command_t report_rate_test[] PROGMEM = {
+    SET_ECHOES(0),
+    STEP(L_right, FAST_HOLD),
+    STEP(hang, FAST_RELEASE)
+};
+#endif
+
+#ifdef TRACE_REPLAY
+#include "trace.h"
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <util/atomic.h>
+#include <string.h>
+
+#include "recorder.h"
+#include "serial.h"
+#include "timer.h"
+
+#ifdef TRACE_RECORDER
+
+// Steps are written at SET_ECHOES(0), lasting 5 ms per duration unit, and
+// a long step's duration byte tops out at 255
+#define STEP_UNIT_MS    5
+#define STEP_UNITS_MAX  256
+
+// The report being passed on, nothing pressed with the HAT and sticks
+// centred until the host sends one, and when it arrived
+static uint8_t report[RECORDER_REPORT_SIZE] = NEUTRAL_REPORT;
+static uint32_t report_started_ms;
+
+// The newest report from the host. The Switch only sees one report a poll,
+// so one that's replaced before the next poll wouldn't have reached it
+// anyway.
+static volatile uint8_t received[RECORDER_REPORT_SIZE];
+static volatile uint32_t received_ms;
+static volatile bool received_new = false;
+
+// The longest line put_step() writes. The serial port is slower than a
+// human can change the sticks, so lines queue up for it.
+#define LINE_MAX 56
+
+static void put_string(const char* s) {
+	while (*s)
+		Serial_Put(*s++);
+}
+
+static void put_number(uint16_t n) {
+	char digits[5];
+	uint8_t count = 0;
+
+	do {
+		digits[count++] = '0' + n % 10;
+		n /= 10;
+	} while (n);
+
+	while (count)
+		Serial_Put(digits[--count]);
+}
+
+static void put_hex(uint16_t n) {
+	put_string("0x");
+
+	for (int8_t shift = 12; shift >= 0; shift -= 4)
+		Serial_Put("0123456789ABCDEF"[(n >> shift) & 0x0F]);
+}
+
+// Writes out the current report, held for `units` of STEP_UNIT_MS
+static void put_step(uint16_t units) {
+	put_string("    RAW_STEP(");
+	put_number(units - 1);
+	put_string(", ");
+	put_hex(report[0] | (report[1] << 8));
+
+	for (uint8_t i = 2; i < RECORDER_REPORT_SIZE; i++)
+	{
+		put_string(", ");
+		put_number(report[i]);
+	}
+
+	put_string("),\n");
+}
+
+// Takes each report the host sends, from the receive interrupt
+static void receive(const uint8_t* payload) {
+	// Only a change starts a new step
+	const uint8_t* latest = received_new ? (const uint8_t*)received : report;
+
+	if (memcmp(payload, latest, RECORDER_REPORT_SIZE) == 0)
+		return;
+
+	memcpy((uint8_t*)received, payload, RECORDER_REPORT_SIZE);
+	received_ms = get_time_ms();
+	received_new = true;
+}
+
+void Recorder_Init(void) {
+	Serial_Init(RECORDER_BAUD, RECORDER_SYNC, RECORDER_REPORT_SIZE, receive);
+
+	// Everything recorded is in STEP_UNIT_MS steps
+	put_string("    SET_ECHOES(0),\n");
+	report_started_ms = get_time_ms();
+}
+
+void Recorder_Task(uint8_t* report_out) {
+	// At most one line a poll, and only once there's room for it, so a burst
+	// of changes queues up here rather than overflowing the output
+	if (Serial_Free() >= LINE_MAX)
+	{
+		uint32_t step_end_ms = report_started_ms + (uint32_t)STEP_UNITS_MAX * STEP_UNIT_MS;
+		uint8_t changed[RECORDER_REPORT_SIZE];
+		uint32_t changed_ms = 0;
+		bool change = false;
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if (received_new)
+			{
+				memcpy(changed, (const uint8_t*)received, RECORDER_REPORT_SIZE);
+				changed_ms = received_ms;
+				change = true;
+			}
+		}
+
+		if (timer_reached(step_end_ms) && (!change || (int32_t)(changed_ms - step_end_ms) >= 0))
+		{
+			// Held for as long as a step can last, so write out a whole
+			// one and keep timing the rest
+			put_step(STEP_UNITS_MAX);
+			report_started_ms = step_end_ms;
+		}
+		else if (change)
+		{
+			uint16_t units = (changed_ms - report_started_ms + STEP_UNIT_MS / 2) / STEP_UNIT_MS;
+
+			if (units)
+				put_step(units);
+
+			// The receive interrupt compares new frames against this
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+			{
+				memcpy(report, changed, RECORDER_REPORT_SIZE);
+				if (received_ms == changed_ms)
+					received_new = false;
+			}
+
+			report_started_ms = changed_ms;
+		}
+	}
+
+	memcpy(report_out, report, RECORDER_REPORT_SIZE);
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _RECORDER_H_
+#define _RECORDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Trace recorder ("make recorder"). A host reads a real controller and sends
+// each report it sees over the 16u2's serial port. The bot passes them
+// straight on to the Switch, so whoever is playing sees the game respond as
+// usual, and writes back each report with how long it was held, as
+// RAW_STEP() lines ready to paste into a step table.
+//
+// Frames from the host are RECORDER_SYNC, then the report (Button low byte,
+// Button high byte, HAT, LX, LY, RX, RY), then the low byte of the sum of
+// those seven bytes.
+#define RECORDER_BAUD        57600
+#define RECORDER_SYNC        0xA5
+#define RECORDER_REPORT_SIZE 7
+
+void Recorder_Init(void);
+// Writes out any step that's finished and copies out the report to pass on,
+// call it every poll.
+void Recorder_Task(uint8_t* report);
+
+#endif
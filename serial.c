@@ -0,0 +1,101 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "serial.h"
+
+// Only built in for the builds that use it, so the others keep the serial
+// port interrupts free
+#ifdef SERIAL_FRAMES
+
+static uint8_t frame_sync;
+static uint8_t frame_payload_size;
+static serial_frame_handler_t frame_handler;
+
+// The frame being read in, sync byte and checksum included
+static uint8_t frame[SERIAL_PAYLOAD_MAX + 2];
+static uint8_t frame_length = 0;
+
+static uint8_t output[SERIAL_OUTPUT_SIZE];
+static volatile uint8_t output_head = 0;
+static volatile uint8_t output_tail = 0;
+
+void Serial_Init(uint32_t baud, uint8_t sync, uint8_t payload_size, serial_frame_handler_t handler) {
+	frame_sync = sync;
+	frame_payload_size = payload_size;
+	frame_handler = handler;
+
+	// Double speed divides 16 MHz exactly for 250000 baud, and keeps 57600
+	// within 1%
+	UCSR1A = (1 << U2X1);
+	UBRR1  = (F_CPU / 8 + baud / 2) / baud - 1;
+	UCSR1C = (1 << UCSZ11) | (1 << UCSZ10);
+	UCSR1B = (1 << TXEN1);
+
+	if (handler)
+		UCSR1B |= (1 << RXEN1) | (1 << RXCIE1);
+}
+
+uint8_t Serial_Free(void) {
+	return (output_tail - output_head - 1 + SERIAL_OUTPUT_SIZE) % SERIAL_OUTPUT_SIZE;
+}
+
+void Serial_Put(uint8_t byte) {
+	output[output_head] = byte;
+	output_head = (output_head + 1) % SERIAL_OUTPUT_SIZE;
+	UCSR1B |= (1 << UDRIE1);
+}
+
+bool Serial_Send_Frame(uint8_t sync, const uint8_t* payload, uint8_t size) {
+	uint8_t sum = 0;
+
+	if (Serial_Free() < size + 2)
+		return false;
+
+	Serial_Put(sync);
+	for (uint8_t i = 0; i < size; i++)
+	{
+		Serial_Put(payload[i]);
+		sum += payload[i];
+	}
+	Serial_Put(sum);
+
+	return true;
+}
+
+ISR(USART1_RX_vect) {
+	uint8_t byte = UDR1;
+
+	// Wait for the start of a frame
+	if (frame_length == 0 && byte != frame_sync)
+		return;
+
+	frame[frame_length++] = byte;
+	if (frame_length < frame_payload_size + 2)
+		return;
+
+	frame_length = 0;
+
+	uint8_t sum = 0;
+	for (uint8_t i = 1; i <= frame_payload_size; i++)
+		sum += frame[i];
+
+	// A bad frame could be a sync byte that was really data, so drop it and
+	// look for the next one
+	if (sum != frame[frame_payload_size + 1])
+		return;
+
+	frame_handler(&frame[1]);
+}
+
+ISR(USART1_UDRE_vect) {
+	if (output_tail == output_head)
+	{
+		UCSR1B &= ~(1 << UDRIE1);
+		return;
+	}
+
+	UDR1 = output[output_tail];
+	output_tail = (output_tail + 1) % SERIAL_OUTPUT_SIZE;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _SERIAL_H_
+#define _SERIAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Framed links over the 16u2's serial port, for the builds that take reports
+// from or pass them to another board or host: the trace recorder and
+// fan-out. Serial feedback is single bytes and polled, so it doesn't use it.
+//
+// A frame is a sync byte, the payload, then the low byte of the sum of the
+// payload. Received frames are handed over from the receive interrupt, and
+// anything sent is queued and sent from the transmit interrupt, so neither
+// holds up the USB polls.
+#if defined(TRACE_RECORDER) || defined(FANOUT_LEADER) || defined(FANOUT_FOLLOWER)
+	#define SERIAL_FRAMES
+#endif
+
+#define SERIAL_PAYLOAD_MAX 8
+
+// The recorder's lines are longer than fan-out frames
+#ifdef TRACE_RECORDER
+	#define SERIAL_OUTPUT_SIZE 128
+#else
+	#define SERIAL_OUTPUT_SIZE 64
+#endif
+
+// A report with nothing pressed and the HAT and sticks centred, as Button low
+// byte, Button high byte, HAT, LX, LY, RX, RY
+#define NEUTRAL_REPORT { 0, 0, 0x08, 128, 128, 128, 128 }
+
+// Called from the receive interrupt with the payload of each good frame
+typedef void (*serial_frame_handler_t)(const uint8_t* payload);
+
+// Sets up the port at `baud`, 8N1. With a handler, frames starting with
+// `sync` and carrying `payload_size` bytes are received for it; without one
+// the receiver stays off.
+void Serial_Init(uint32_t baud, uint8_t sync, uint8_t payload_size, serial_frame_handler_t handler);
+// How many bytes the transmit queue has room for
+uint8_t Serial_Free(void);
+// Queues a byte. Callers check there's room first.
+void Serial_Put(uint8_t byte);
+// Queues a frame, or nothing if there isn't room for all of it. Returns
+// whether it was queued.
+bool Serial_Send_Frame(uint8_t sync, const uint8_t* payload, uint8_t size);
+
+#endif
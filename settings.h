@@ -1,11 +1,15 @@
 #ifndef _SETTINGS_H_
 #define _SETTINGS_H_
 
+// Defaults for the runtime settings in config.h. A host can change them
+// without reflashing (see the README).
+
 #define nat_dex_number 810
     // National Pokedex Number of what you're hatching
     // Determines the egg cycles and hatching time
 #define number_of_boxes 1
     // How many boxes of eggs to hatch
+    // 0 = Keep going until unplugged, or for 31 boxes with release_boxes
 #define save 0
     // 0 = Don't save at all
     // 1 = Save after every box
@@ -19,5 +23,22 @@
 #define subsequent_egg_checks 38
     // How many atempts to collect 30 eggs in subsequent rounds
     // Additional eggs from previous rounds should make up for the loss
+#define column_egg_checks 0
+    // How many attempts to collect eggs for the next box between columns,
+    // on the way back from the nursery after each hatch
+    // Each one takes an attempt off the next round's subsequent_egg_checks
+#define release_boxes 0
+    // 0 = Keep everything that hatches
+    // 1 = Release each box once it's hatched, so the boxes can be reused
+    //     Needs make with-serial-feedback, and only releases full boxes
+    //     Use this at your own risk
+
+#define timing_profile 0
+    // How long to wait for menus, text and loading
+    // 0 = Standard, the timings the bot was tested with
+    // 1 = Quick, for a console that loads fast (e.g. docked, games on the
+    //     system memory)
+    // 2 = Patient, for a slow console (e.g. a Lite, games on a slow SD card)
+    //     or longer text
 
 #endif
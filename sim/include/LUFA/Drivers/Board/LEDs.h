@@ -0,0 +1 @@
+// Not used by the firmware; exists so the include resolves on the host.
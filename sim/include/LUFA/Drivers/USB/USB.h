@@ -0,0 +1,63 @@
+// Host stand-in for the parts of LUFA the firmware uses. The simulator never
+// enumerates, so every call is a no-op and the device is never configured.
+#ifndef _SIM_LUFA_USB_H_
+#define _SIM_LUFA_USB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ATTR_WARN_UNUSED_RESULT
+#define ATTR_NON_NULL_PTR_ARG(...)
+
+typedef struct { uint8_t Size, Type; } USB_Descriptor_Header_t;
+typedef struct { USB_Descriptor_Header_t Header; } USB_Descriptor_Configuration_Header_t;
+typedef struct { USB_Descriptor_Header_t Header; } USB_Descriptor_Interface_t;
+typedef struct { USB_Descriptor_Header_t Header; } USB_HID_Descriptor_HID_t;
+typedef struct { USB_Descriptor_Header_t Header; } USB_Descriptor_Endpoint_t;
+
+typedef struct {
+	uint8_t  bmRequestType;
+	uint8_t  bRequest;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} USB_Request_Header_t;
+
+#define ENDPOINT_DIR_IN           0x80
+#define ENDPOINT_DIR_OUT          0x00
+#define EP_TYPE_INTERRUPT         0x03
+#define ENDPOINT_RWSTREAM_NoError 0
+#define DEVICE_STATE_Unattached   0
+#define DEVICE_STATE_Configured   4
+#define REQDIR_HOSTTODEVICE       (0 << 7)
+#define REQDIR_DEVICETOHOST       (1 << 7)
+#define REQTYPE_VENDOR            (2 << 5)
+#define REQREC_DEVICE             (0 << 0)
+
+static volatile uint8_t USB_DeviceState = DEVICE_STATE_Unattached;
+static USB_Request_Header_t USB_ControlRequest __attribute__((unused));
+
+static inline void USB_Init(void) {}
+static inline void USB_USBTask(void) {}
+static inline void USB_Device_EnableSOFEvents(void) {}
+static inline void USB_Device_DisableSOFEvents(void) {}
+static inline void GlobalInterruptEnable(void) {}
+static inline bool Endpoint_ConfigureEndpoint(uint8_t address, uint8_t type, uint16_t size, uint8_t banks) { return true; }
+static inline void Endpoint_SelectEndpoint(uint8_t address) {}
+static inline bool Endpoint_IsOUTReceived(void) { return false; }
+static inline bool Endpoint_IsINReady(void) { return false; }
+static inline bool Endpoint_IsReadWriteAllowed(void) { return false; }
+static inline uint16_t Endpoint_BytesInEndpoint(void) { return 0; }
+static inline uint8_t Endpoint_Read_8(void) { return 0; }
+static inline void Endpoint_Write_8(uint8_t data) {}
+static inline uint8_t Endpoint_Read_Stream_LE(void* buffer, uint16_t length, uint16_t* progress) { return ENDPOINT_RWSTREAM_NoError; }
+static inline uint8_t Endpoint_Write_Stream_LE(const void* buffer, uint16_t length, uint16_t* progress) { return ENDPOINT_RWSTREAM_NoError; }
+static inline uint8_t Endpoint_Write_Control_Stream_LE(const void* buffer, uint16_t length) { return 0; }
+static inline uint8_t Endpoint_Read_Control_Stream_LE(void* buffer, uint16_t length) { return 0; }
+static inline void Endpoint_ClearIN(void) {}
+static inline void Endpoint_ClearOUT(void) {}
+static inline void Endpoint_ClearSETUP(void) {}
+static inline void Endpoint_ClearStatusStage(void) {}
+
+#endif
@@ -0,0 +1,16 @@
+// Host stand-in for <avr/eeprom.h>: EEPROM is ordinary memory, and starts
+// out blank on every run.
+#ifndef _SIM_AVR_EEPROM_H_
+#define _SIM_AVR_EEPROM_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define EEMEM
+
+static inline uint8_t eeprom_read_byte(const uint8_t* addr) { return *addr; }
+static inline void eeprom_update_byte(uint8_t* addr, uint8_t value) { *addr = value; }
+static inline void eeprom_read_block(void* dst, const void* src, size_t size) { memcpy(dst, src, size); }
+static inline void eeprom_update_block(const void* src, void* dst, size_t size) { memcpy(dst, src, size); }
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef _SIM_AVR_INTERRUPT_H_
+#define _SIM_AVR_INTERRUPT_H_
+
+#define ISR(vector) void vector(void)
+#define sei()
+#define cli()
+
+#endif
@@ -0,0 +1,40 @@
+// Host stand-in for <avr/io.h>: registers are plain variables the firmware
+// can write to without effect.
+#ifndef _SIM_AVR_IO_H_
+#define _SIM_AVR_IO_H_
+
+#include <stdint.h>
+
+static volatile uint8_t MCUSR, DDRB, PORTB, PINB, DDRD, PORTD, PIND;
+static volatile uint8_t TCCR0A, TCCR0B, OCR0A, TIMSK0;
+static volatile uint8_t UCSR1A, UCSR1B, UCSR1C;
+static volatile uint16_t UBRR1;
+
+#define WDRF   3
+#define WGM01  1
+#define CS00   0
+#define CS01   1
+#define OCIE0A 1
+#define RXEN1  4
+#define TXEN1  3
+#define UCSZ10 1
+#define UCSZ11 2
+#define UDRE1  5
+#define RXC1   7
+#define U2X1   1
+#define UDRIE1 5
+#define RXCIE1 7
+
+// Serial feedback comes from the simulator, which puts a byte in sim_udr1
+// and sets RXC1. Reading UDR1 takes it, as on the real USART. A byte
+// written to UDR1 is left in sim_udr1 for the simulator to pick up.
+static volatile uint8_t sim_udr1;
+
+static inline volatile uint8_t* sim_udr1_register(void) {
+	UCSR1A &= ~(1 << RXC1);
+	return &sim_udr1;
+}
+
+#define UDR1 (*sim_udr1_register())
+
+#endif
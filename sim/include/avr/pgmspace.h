@@ -0,0 +1,15 @@
+// Host stand-in for <avr/pgmspace.h>: flash is ordinary memory.
+#ifndef _SIM_AVR_PGMSPACE_H_
+#define _SIM_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(const void* const*)(addr))
+#define memcpy_P             memcpy
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef _SIM_AVR_POWER_H_
+#define _SIM_AVR_POWER_H_
+
+#define clock_div_1 0
+#define clock_prescale_set(div)
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef _SIM_AVR_WDT_H_
+#define _SIM_AVR_WDT_H_
+
+#define wdt_disable()
+#define wdt_enable(timeout)
+#define wdt_reset()
+
+#endif
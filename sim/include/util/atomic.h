@@ -0,0 +1,7 @@
+#ifndef _SIM_UTIL_ATOMIC_H_
+#define _SIM_UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(type) for (int _done = 0; !_done; _done = 1)
+
+#endif
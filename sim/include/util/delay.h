@@ -0,0 +1,6 @@
+#ifndef _SIM_UTIL_DELAY_H_
+#define _SIM_UTIL_DELAY_H_
+
+#define _delay_ms(ms)
+
+#endif
@@ -0,0 +1,277 @@
+/*
+Host-side simulator for the egg collector
+
+Runs the firmware's GetNextReport() state machine on a PC against a virtual
+millisecond clock, polling it every POLLING_INTERVAL_MS the way the Switch
+would. It reports how much wall time a run spends in each state and on each
+box for the current settings.h, and can dump every report it would send.
+
+	sim              summary only
+	sim --trace      also print every report, run-length encoded
+	sim --hours N    give up after N simulated hours (default 200)
+	sim --egg-chance P
+	                 with SIM_FLAGS=-DSERIAL_FEEDBACK, each talk to the
+	                 nursery worker gets an egg with probability P and sends
+	                 the 'E' for it (default 0.8)
+	sim --target-at S
+	                 with SIM_FLAGS=-DSERIAL_FEEDBACK, send the 'T' for the
+	                 target hatching S seconds in, or with -DTARGET_PIN pull
+	                 the pin low then
+
+With SIM_FLAGS=-DFANOUT_LEADER the serial port is stubbed: what the leader
+queues goes out at the baud rate, and the summary says how many polls each
+follower went without a frame.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The firmware is built straight into the simulator, with its main() renamed
+// out of the way. Nothing in it is touched otherwise.
+#define main firmware_main
+#include "../Joystick.c"
+#undef main
+#include "../feedback.c"
+#include "../config.c"
+#include "../checkpoint.c"
+#include "../serial.c"
+#include "../fanout.c"
+
+// The virtual clock stands in for timer.c
+static uint32_t sim_time_ms = 0;
+
+void Timer_Init(void) {
+}
+
+uint32_t get_time_ms(void) {
+	return sim_time_ms;
+}
+
+bool timer_reached(uint32_t target_ms) {
+	return (int32_t)(sim_time_ms - target_ms) >= 0;
+}
+
+#ifdef FANOUT_LEADER
+// What's on the wire to the followers: the frame being read back in, and
+// the polls each follower has gone without a whole frame for it
+static uint8_t sim_frame[FANOUT_FRAME_SIZE];
+static uint8_t sim_frame_length = 0;
+static bool sim_heard[FANOUT_CONSOLES];
+static uint32_t sim_missed[FANOUT_CONSOLES];
+
+// Sends what a poll's worth of serial port time allows, 10 bits a byte
+static void sim_serial_poll(void) {
+	for (uint32_t i = 0; i < FANOUT_BAUD / 10 * POLLING_INTERVAL_MS / 1000; i++)
+	{
+		if (!(UCSR1B & (1 << UDRIE1)))
+			break;
+
+		USART1_UDRE_vect();
+		if (!(UCSR1B & (1 << UDRIE1)))
+			break;
+
+		uint8_t byte = sim_udr1;
+
+		if (sim_frame_length == 0 && byte != FANOUT_SYNC)
+			continue;
+
+		sim_frame[sim_frame_length++] = byte;
+		if (sim_frame_length == sizeof(sim_frame))
+		{
+			uint8_t sum = 0;
+			for (uint8_t j = 1; j < sizeof(sim_frame) - 1; j++)
+				sum += sim_frame[j];
+
+			if (sum == sim_frame[sizeof(sim_frame) - 1] && sim_frame[1] < FANOUT_CONSOLES)
+				sim_heard[sim_frame[1]] = true;
+			sim_frame_length = 0;
+		}
+	}
+
+	for (uint8_t console = 1; console < FANOUT_CONSOLES; console++)
+	{
+		if (!sim_heard[console])
+			sim_missed[console]++;
+		sim_heard[console] = false;
+	}
+}
+#endif
+
+static const char* const state_names[] = {
+	"SYNC_CONTROLLER",
+	"BREATHE",
+	"FLY_TO_NURSERY",
+	"IN_OUT_NURSERY",
+	"GO_TO_CIRCLE1",
+	"CIRCLE1",
+	"APPROACH_NPC",
+	"SPEAK",
+	"GO_TO_CIRCLE2",
+	"GO_TO_CIRCLE3",
+	"OPEN_BOX",
+	"SELECT_COL",
+	"GRAB_EGGS_PRE",
+	"RELEASE_BOX",
+	"SELECT_COL2",
+	"GRAB_EGGS_POST",
+	"CLOSE_BOX",
+	"CIRCLE_CW",
+	"RESYNC",
+	"SAVE",
+	"SLEEP",
+	"DONE",
+	"BENCHMARK",
+	"RECORD",
+	"REPLAY",
+	"FOLLOW",
+};
+
+_Static_assert(ARRAY_SIZE(state_names) == STATE_COUNT, "state_names doesn't match State_t");
+
+static void print_report(uint32_t time_ms, State_t report_state, const USB_JoystickReport_Input_t* report, uint32_t polls) {
+	printf("%10.3f  %-16s  buttons=%04x hat=%u  L=(%3u,%3u) R=(%3u,%3u)  x%u\n",
+		time_ms / 1000.0, state_names[report_state], report->Button, report->HAT,
+		report->LX, report->LY, report->RX, report->RY, polls);
+}
+
+int main(int argc, char** argv) {
+	bool trace = false;
+	double limit_hours = 200;
+	double egg_chance = 0.8;
+	double target_at = -1;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--trace"))
+			trace = true;
+		else if (!strcmp(argv[i], "--hours") && i + 1 < argc)
+			limit_hours = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--egg-chance") && i + 1 < argc)
+			egg_chance = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--target-at") && i + 1 < argc)
+			target_at = atof(argv[++i]);
+		else
+		{
+			fprintf(stderr, "usage: %s [--trace] [--hours N] [--egg-chance P] [--target-at S]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	// Blank EEPROM, so the settings.h values
+	Config_Init();
+	#ifdef FANOUT_LEADER
+	Fanout_Init();
+	#endif
+
+	#ifdef TARGET_PIN
+	// Held high by its pull-up until the target hatches
+	PINB |= (1 << TARGET_PIN_BIT);
+	#endif
+
+	uint64_t state_ms[ARRAY_SIZE(state_names)] = { 0 };
+	uint32_t limit_ms = limit_hours * 3600 * 1000;
+	uint32_t box_started = 0;
+	uint8_t boxes_left = 0;
+	uint8_t boxes_done = 0;
+
+	// The trace only prints a line when the report or the state changes
+	USB_JoystickReport_Input_t report, run_report;
+	State_t run_state = state;
+	uint32_t run_started = 0;
+	uint32_t run_polls = 0;
+
+	while (state != DONE && sim_time_ms < limit_ms)
+	{
+		State_t report_state = state;
+
+		NextReport(&report);
+		state_ms[report_state] += POLLING_INTERVAL_MS;
+		#ifdef FANOUT_LEADER
+		sim_serial_poll();
+		#endif
+
+		// rand() is never seeded, so every run is the same and easy to compare
+		if (report_state == SPEAK && state != SPEAK && rand() < egg_chance * ((double)RAND_MAX + 1))
+		{
+			sim_udr1 = FEEDBACK_EGG;
+			UCSR1A |= (1 << RXC1);
+		}
+		else if (target_at >= 0 && sim_time_ms >= target_at * 1000)
+		{
+			// The target hatches, S seconds in
+			#ifdef TARGET_PIN
+			PINB &= ~(1 << TARGET_PIN_BIT);
+			#else
+			sim_udr1 = FEEDBACK_TARGET;
+			UCSR1A |= (1 << RXC1);
+			#endif
+			target_at = -1;
+		}
+
+		if (trace)
+		{
+			if (run_polls > 0 && (report_state != run_state || memcmp(&report, &run_report, sizeof(report))))
+			{
+				print_report(run_started, run_state, &run_report, run_polls);
+				run_polls = 0;
+			}
+
+			if (run_polls == 0)
+			{
+				run_report = report;
+				run_state = report_state;
+				run_started = sim_time_ms;
+			}
+
+			run_polls++;
+		}
+
+		// The run's box count is only known once it's synced
+		if (report_state == SYNC_CONTROLLER)
+			boxes_left = num_boxes;
+
+		if (num_boxes != boxes_left)
+		{
+			boxes_done++;
+			printf("box %u: %.1f s (estimated %.1f s)\n", boxes_done, (sim_time_ms - box_started) / 1000.0,
+				(boxes_done == 1 ? estimate.first_box_ms : boxes_done == run_boxes ? estimate.last_box_ms : estimate.box_ms) / 1000.0);
+			box_started = sim_time_ms;
+			boxes_left = num_boxes;
+		}
+
+		sim_time_ms += POLLING_INTERVAL_MS;
+	}
+
+	if (trace && run_polls > 0)
+		print_report(run_started, run_state, &run_report, run_polls);
+
+	printf("\n%-16s  %10s  %6s\n", "state", "time (s)", "share");
+	for (unsigned i = 0; i < ARRAY_SIZE(state_names); i++)
+	{
+		if (state_ms[i])
+			printf("%-16s  %10.1f  %5.1f%%\n", state_names[i], state_ms[i] / 1000.0, 100.0 * state_ms[i] / sim_time_ms);
+	}
+
+	printf("\ntotal: %.1f s for %u box(es) at %u ms polling\n", sim_time_ms / 1000.0, boxes_done, POLLING_INTERVAL_MS);
+	if (estimate.run_ms && boxes_done > 0)
+		printf("estimated: %.1f s\n", estimate.run_ms / 1000.0);
+	if (boxes_done > 0)
+		printf("eggs per hour: %.1f\n", boxes_done * EGGS_PER_BOX * 3600000.0 / box_started);
+	#ifdef FANOUT_LEADER
+	for (uint8_t console = 1; console < FANOUT_CONSOLES; console++)
+		printf("follower %u: %u polls without a frame\n", console, sim_missed[console]);
+	#endif
+
+	if (state != DONE && config.boxes == 0)
+	{
+		printf("continuous run, stopped after %.0f simulated hours\n", limit_hours);
+	}
+	else if (state != DONE)
+	{
+		printf("gave up after %.0f simulated hours without reaching DONE\n", limit_hours);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,35 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "timer.h"
+
+static volatile uint32_t time_ms = 0;
+
+// Sets up Timer0 in CTC mode to interrupt once every millisecond.
+void Timer_Init(void) {
+	TCCR0A = (1 << WGM01);
+	TCCR0B = (1 << CS01) | (1 << CS00); // F_CPU / 64
+	OCR0A  = (F_CPU / 64 / 1000) - 1;
+	TIMSK0 = (1 << OCIE0A);
+}
+
+ISR(TIMER0_COMPA_vect) {
+	time_ms++;
+}
+
+uint32_t get_time_ms(void) {
+	uint32_t now;
+
+	// A 32 bit read isn't atomic on AVR, so keep the tick from landing halfway through it.
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		now = time_ms;
+	}
+
+	return now;
+}
+
+bool timer_reached(uint32_t target_ms) {
+	return (int32_t)(get_time_ms() - target_ms) >= 0;
+}
@@ -0,0 +1,15 @@
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Millisecond clock, ticked by Timer0. It wraps after about 49 days, so
+// compare times with timer_reached() rather than directly.
+void Timer_Init(void);
+uint32_t get_time_ms(void);
+
+// True once the clock has reached the given time
+bool timer_reached(uint32_t target_ms);
+
+#endif
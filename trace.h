@@ -0,0 +1,12 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+// The trace "make replay" plays back once the controller has synced, then
+// stops. Paste what "make recorder" wrote out over this placeholder, which
+// just waits a second.
+static const command_t recorded_trace[] PROGMEM = {
+    SET_ECHOES(0),
+    RAW_STEP(199, 0x0000, 8, 128, 128, 128, 128)
+};
+
+#endif